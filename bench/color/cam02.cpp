@@ -0,0 +1,92 @@
+#include <cmath>
+#include <cstdio>
+
+#include <imp/color/cam02>
+
+#include "measure"
+
+
+//
+// CIECAM02 throughput and accuracy: double reference, float planes and sRGB 3D LUT
+// on a 12 MPix image, single thread (build with -O3 to get vectorized rows)
+//
+
+namespace
+{
+
+
+void run(const imp::Cam02& cam, const imp::RgbImage<uint8_t>& image8)
+{
+    const index_t size = image8.plane_size();
+
+    imp::RgbImage<float> linear(image8.height(), image8.width());
+
+    for (index_t i = 0; i < 3*size; ++i)
+        linear.data()[i] = imp::Srgb::eotf(float(image8.data()[i]) / 255);
+
+    const imp::Matrix<double, 3, 3> rgb_to_xyz = 100*imp::internal::srgb_to_xyz();
+
+    imp::LabImage<float> reference(image8.height(), image8.width());
+
+    double bytes = double(3*size*index_t(sizeof(float)));
+
+    double t_reference = bench::measure([&]
+    {
+        for (index_t i = 0; i < size; ++i)
+        {
+            imp::Vector<double, 3> jch = cam.xyz_to_jch(rgb_to_xyz*imp::Vector<double, 3>(linear.r(i), linear.g(i), linear.b(i)));
+
+            double h = jch(2) * (3.14159265358979323846 / 180);
+
+            reference.l(i) = float(jch(0));
+            reference.a(i) = float(jch(1)*std::cos(h));
+            reference.b(i) = float(jch(1)*std::sin(h));
+        }
+    }, 1);
+
+    imp::LabImage<float> fast(1, 1);
+
+    double t_fast = bench::measure([&] { fast = cam.rgb_to_jab(linear); }, 3);
+
+    imp::BakeError bake;
+
+    auto lut = cam.bake_srgb_lut(65, &bake);
+
+    imp::LabImage<float> looked_up(image8.height(), image8.width());
+
+    double t_lut = bench::measure([&] { lut.apply(image8, looked_up); }, 3);
+
+    bench::report("reference (double)", t_reference, bytes);
+    bench::report("float planes      ", t_fast, bytes, t_reference);
+    bench::report("lut 65 (uint8_t)  ", t_lut, bytes, t_reference);
+
+    std::printf("float planes:  max error %.2e, mean %.2e\n",
+                double((fast.array() - reference.array()).abs().maxCoeff()),
+                double((fast.array() - reference.array()).abs().mean()));
+
+    std::printf("lut 65:        max error %.2e, mean %.2e (baker: max %.2e, mean %.2e)\n",
+                double((looked_up.array() - reference.array()).abs().maxCoeff()),
+                double((looked_up.array() - reference.array()).abs().mean()),
+                bake.max_error, bake.mean_error);
+}
+
+
+}
+
+
+int main()
+{
+    imp::RgbImage<uint8_t> image8(3000, 4000);
+
+    for (index_t y = 0; y < image8.height(); ++y)
+        for (index_t x = 0; x < image8.width(); ++x)
+        {
+            image8.r(x, y) = uint8_t((x*7 + y) % 256);
+            image8.g(x, y) = uint8_t((y*13 + x*3) % 256);
+            image8.b(x, y) = uint8_t((x*y + 11) % 256);
+        }
+
+    run(imp::Cam02(), image8);
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <cmath>
+#include <cstdio>
+
+#include <imp/filter/bilateral>
+
+#include "measure"
+
+
+//
+// Bilateral filter, single thread: bilateral grid throughput over the spatial sigma on a
+// 12 MPix 8-bit plane and RGB image, then grid against the exact filter (throughput and
+// error) on a 512 x 512 crop
+//
+
+namespace
+{
+
+
+imp::Matrix<uint8_t> test_plane(index_t rows, index_t cols)
+{
+    imp::Matrix<uint8_t> plane(rows, cols);
+
+    uint32_t state = 1;
+
+    // smooth shading, sharp shapes, noise
+    for (index_t y = 0; y < rows; ++y)
+        for (index_t x = 0; x < cols; ++x)
+        {
+            state = state*1664525u + 1013904223u;
+
+            double value = 60 + 40*std::sin(double(x) / 300) * std::cos(double(y) / 200)
+                         + ((x / 250 + y / 180) % 2 ? 90 : 0)
+                         + double(state >> 28) - 7.5;
+
+            plane(y, x) = uint8_t(std::min(std::max(value, 0.0), 255.0));
+        }
+
+    return plane;
+}
+
+
+}
+
+
+int main()
+{
+    const auto plane = test_plane(3000, 4000);
+
+    imp::RgbImage<uint8_t> image(3000, 4000);
+
+    image.plane(0) = plane;
+    image.plane(1) = (plane.cast<int>()*3/4 + imp::Matrix<int>::Constant(3000, 4000, 30)).cast<uint8_t>();
+    image.plane(2) = (imp::Matrix<int>::Constant(3000, 4000, 255) - plane.cast<int>()).cast<uint8_t>();
+
+    const double bytes = double(plane.size());
+
+    std::printf("grid, 12 MPix, sr = 20\n");
+
+    for (double ss : { 4.0, 8.0, 16.0, 32.0 })
+    {
+        char name[64];
+
+        double t = bench::measure([&] { auto result = imp::BilateralFilter(ss, 20).apply(plane); }, 2);
+
+        std::snprintf(name, sizeof(name), "  plane  ss %4.1f", ss);
+        bench::report(name, t, bytes);
+
+        t = bench::measure([&] { auto result = imp::BilateralFilter(ss, 20).apply(image); }, 2);
+
+        std::snprintf(name, sizeof(name), "  rgb    ss %4.1f", ss);
+        bench::report(name, t, 3*bytes);
+    }
+
+    const imp::Matrix<uint8_t> crop = plane.block(1000, 1000, 512, 512);
+
+    const double crop_bytes = double(crop.size());
+
+    std::printf("grid against exact, 512 x 512\n");
+
+    for (double ss : { 4.0, 8.0 })
+        for (double sr : { 10.0, 30.0 })
+        {
+            imp::Matrix<uint8_t> exact, grid;
+
+            double t_exact = bench::measure([&] { exact = imp::BilateralFilter(ss, sr, imp::kBilateralExact).apply(crop); }, 1);
+            double t_grid  = bench::measure([&] { grid  = imp::BilateralFilter(ss, sr).apply(crop); }, 3);
+
+            char name[64];
+
+            std::snprintf(name, sizeof(name), "  exact  ss %4.1f sr %4.1f", ss, sr);
+            bench::report(name, t_exact, crop_bytes);
+
+            std::snprintf(name, sizeof(name), "  grid   ss %4.1f sr %4.1f", ss, sr);
+            bench::report(name, t_grid, crop_bytes, t_exact);
+
+            const auto error = (grid.cast<double>() - exact.cast<double>()).array().abs();
+
+            std::printf("         error: mean %.2f, max %.0f, PSNR %.1f dB\n", error.mean(), error.maxCoeff(),
+                        10*std::log10(255.0*255.0 / error.square().mean()));
+        }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <cstdio>
+
+#include <imp/filter/convolution>
+
+#include "measure"
+
+
+//
+// Convolution, single thread, 12 MPix 8-bit and float planes: compile-time kernels
+// (unrolled) against the same kernels of runtime size (tiled), non-separable and
+// separable
+//
+
+namespace
+{
+
+
+imp::Matrix<float> test_kernel(index_t rows, index_t cols)
+{
+    imp::Matrix<float> kernel(rows, cols);
+
+    for (index_t i = 0; i < rows; ++i)
+        for (index_t j = 0; j < cols; ++j)
+            kernel(i, j) = float((i*7 + j*3) % 11) / float(5*rows*cols);
+
+    return kernel;
+}
+
+
+template <class Filter, typename T>
+void run(const char* name, const Filter& filter, const imp::Matrix<T>& source, imp::Matrix<T>& dest, double baseline = 0)
+{
+    double t = bench::measure([&] { dest = filter.apply(source); }, 3);
+
+    if (baseline > 0)
+        bench::report(name, t, double(source.size()*index_t(sizeof(T))), baseline);
+    else
+        bench::report(name, t, double(source.size()*index_t(sizeof(T))));
+}
+
+
+template <typename T>
+void run_all(const char* type, const imp::Matrix<T>& source)
+{
+    imp::Matrix<T> dest;
+
+    std::printf("%s, non-separable\n", type);
+
+    {
+        imp::Matrix<float, 3, 3> k3 = test_kernel(3, 3);
+        imp::Matrix<float, 5, 5> k5 = test_kernel(5, 5);
+        imp::Matrix<float, 7, 7> k7 = test_kernel(7, 7);
+
+        double t3 = bench::measure([&] { dest = imp::make_convolution(imp::Matrix<float>(k3)).apply(source); }, 3);
+        run("  3 x 3 runtime", imp::make_convolution(imp::Matrix<float>(k3)), source, dest);
+        run("  3 x 3 fixed", imp::make_convolution(k3), source, dest, t3);
+
+        double t5 = bench::measure([&] { dest = imp::make_convolution(imp::Matrix<float>(k5)).apply(source); }, 3);
+        run("  5 x 5 runtime", imp::make_convolution(imp::Matrix<float>(k5)), source, dest);
+        run("  5 x 5 fixed", imp::make_convolution(k5), source, dest, t5);
+
+        double t7 = bench::measure([&] { dest = imp::make_convolution(imp::Matrix<float>(k7)).apply(source); }, 3);
+        run("  7 x 7 runtime", imp::make_convolution(imp::Matrix<float>(k7)), source, dest);
+        run("  7 x 7 fixed", imp::make_convolution(k7), source, dest, t7);
+
+        run("  15 x 15 runtime", imp::make_convolution(test_kernel(15, 15)), source, dest);
+    }
+
+    std::printf("%s, separable\n", type);
+
+    {
+        imp::RowVector<float, 5>  v5  = test_kernel(1, 5);
+        imp::RowVector<float, 15> v15 = test_kernel(1, 15);
+
+        double t5 = bench::measure([&] { dest = imp::make_convolution(imp::RowVector<float>(v5), imp::RowVector<float>(v5)).apply(source); }, 3);
+        run("  5 + 5 runtime", imp::make_convolution(imp::RowVector<float>(v5), imp::RowVector<float>(v5)), source, dest);
+        run("  5 + 5 fixed", imp::make_convolution(v5, v5), source, dest, t5);
+
+        double t15 = bench::measure([&] { dest = imp::make_convolution(imp::RowVector<float>(v15), imp::RowVector<float>(v15)).apply(source); }, 3);
+        run("  15 + 15 runtime", imp::make_convolution(imp::RowVector<float>(v15), imp::RowVector<float>(v15)), source, dest);
+        run("  15 + 15 fixed", imp::make_convolution(v15, v15), source, dest, t15);
+
+        run("  61 + 61 runtime", imp::make_convolution(test_kernel(1, 61), test_kernel(1, 61)), source, dest);
+    }
+}
+
+
+}
+
+
+int main()
+{
+    imp::Matrix<uint8_t> image8(3000, 4000);
+
+    uint32_t state = 1;
+
+    for (index_t y = 0; y < image8.rows(); ++y)
+        for (index_t x = 0; x < image8.cols(); ++x)
+        {
+            state = state*1664525u + 1013904223u;
+            image8(y, x) = uint8_t(((x + y) % 256 + (state >> 28)) & 255);
+        }
+
+    imp::Matrix<float> image32 = image8.cast<float>();
+
+    run_all("uint8_t", image8);
+    run_all("float", image32);
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <cstdio>
+
+#include <imp/filter/distance>
+#include <imp/filter/minmax>
+
+#include "measure"
+
+
+//
+// Distance transform, 12 MPix 8-bit masks of several feature densities: exact euclidean
+// and chamfer, one thread and four; a square MaxFilter dilation for reference against
+// the disk dilation by a threshold of the distance
+//
+
+namespace
+{
+
+
+imp::Matrix<uint8_t> test_mask(index_t rows, index_t cols, uint32_t density)
+{
+    imp::Matrix<uint8_t> mask(rows, cols);
+
+    uint32_t state = 1;
+
+    for (index_t y = 0; y < rows; ++y)
+        for (index_t x = 0; x < cols; ++x)
+        {
+            state = state*1664525u + 1013904223u;
+            mask(y, x) = uint8_t((state >> 8) % density == 0 ? 255 : 0);
+        }
+
+    return mask;
+}
+
+
+}
+
+
+int main()
+{
+    const double bytes = 3000.0*4000.0;
+
+    imp::Matrix<float> dest;
+
+    for (uint32_t density : { 10u, 1000u, 100000u })
+    {
+        const auto mask = test_mask(3000, 4000, density);
+
+        std::printf("12 MPix, one feature of %u\n", density);
+
+        double t = bench::measure([&] { dest = imp::DistanceTransform().apply(mask); }, 2);
+
+        bench::report("  euclidean", t, bytes);
+
+        double t_4 = bench::measure([&] { dest = imp::DistanceTransform().apply(mask, 4); }, 2);
+
+        bench::report("  euclidean, 4 threads", t_4, bytes, t);
+
+        double t_chamfer = bench::measure([&] { dest = imp::DistanceTransform(imp::kDistanceChamfer).apply(mask); }, 2);
+
+        bench::report("  chamfer", t_chamfer, bytes, t);
+    }
+
+    std::printf("dilation of a 12 MPix mask, one feature of 1000\n");
+    {
+        const auto mask = test_mask(3000, 4000, 1000);
+
+        imp::Matrix<uint8_t> dilated;
+
+        double t = bench::measure([&] { dilated = (imp::DistanceTransform(imp::kDistanceSquared).apply<uint32_t>(mask).array() <= 16*16).cast<uint8_t>(); }, 2);
+
+        bench::report("  distance <= r, any r", t, bytes);
+
+        for (index_t radius : { 1, 4, 16 })
+        {
+            char name[64];
+
+            double t_max = bench::measure([&] { dilated = imp::MaxFilter(radius).apply(mask); }, 2);
+
+            std::snprintf(name, sizeof(name), "  MaxFilter, radius %2d", int(radius));
+            bench::report(name, t_max, bytes, t);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <cmath>
+#include <cstdio>
+
+#include <imp/filter/guided>
+
+#include "measure"
+
+
+//
+// Guided filter, single thread, 12 MPix 8-bit: gray self-guided over the radius and the
+// subsampling, a mask refined by an RGB guide, a fresh filter against a reused workspace
+//
+
+namespace
+{
+
+
+imp::Matrix<uint8_t> test_plane(index_t rows, index_t cols)
+{
+    imp::Matrix<uint8_t> plane(rows, cols);
+
+    uint32_t state = 1;
+
+    // smooth shading, sharp shapes, noise
+    for (index_t y = 0; y < rows; ++y)
+        for (index_t x = 0; x < cols; ++x)
+        {
+            state = state*1664525u + 1013904223u;
+
+            double value = 60 + 40*std::sin(double(x) / 300) * std::cos(double(y) / 200)
+                         + ((x / 250 + y / 180) % 2 ? 90 : 0)
+                         + double(state >> 28) - 7.5;
+
+            plane(y, x) = uint8_t(std::min(std::max(value, 0.0), 255.0));
+        }
+
+    return plane;
+}
+
+
+}
+
+
+int main()
+{
+    const auto plane = test_plane(3000, 4000);
+
+    imp::RgbImage<uint8_t> image(3000, 4000);
+
+    image.plane(0) = plane;
+    image.plane(1) = (plane.cast<int>()*3/4 + imp::Matrix<int>::Constant(3000, 4000, 30)).cast<uint8_t>();
+    image.plane(2) = (imp::Matrix<int>::Constant(3000, 4000, 255) - plane.cast<int>()).cast<uint8_t>();
+
+    imp::Matrix<uint8_t> mask = imp::Matrix<uint8_t>::Zero(3000, 4000);
+
+    mask.block(500, 500, 2000, 2500).setConstant(255);
+
+    const double bytes = double(plane.size());
+    const double eps   = 25.5*25.5;
+
+    imp::Matrix<uint8_t> dest;
+
+    std::printf("gray, self-guided, 12 MPix\n");
+
+    for (index_t s : { 1, 2, 4, 8 })
+        for (index_t radius : { 4, 16, 64 })
+        {
+            imp::GuidedFilter filter(radius, eps, s);
+
+            char name[64];
+
+            double t = bench::measure([&] { dest = filter.apply(plane, plane); }, 2);
+
+            std::snprintf(name, sizeof(name), "  s %d  radius %2d", int(s), int(radius));
+            bench::report(name, t, bytes);
+        }
+
+    std::printf("mask, RGB guide, radius 16, 12 MPix\n");
+
+    for (index_t s : { 1, 4 })
+    {
+        imp::GuidedFilter filter(16, eps, s);
+
+        char name[64];
+
+        double t = bench::measure([&] { dest = filter.apply(mask, image); }, 2);
+
+        std::snprintf(name, sizeof(name), "  s %d", int(s));
+        bench::report(name, t, bytes);
+    }
+
+    std::printf("RGB, self-guided, radius 16, s 4, 12 MPix\n");
+    {
+        imp::RgbImage<uint8_t> result(3000, 4000);
+
+        double t = bench::measure([&] { result = imp::GuidedFilter(16, eps, 4).apply(image, image); }, 2);
+
+        bench::report("  fresh filter", t, 3*bytes);
+
+        imp::GuidedFilter filter(16, eps, 4);
+
+        double t_reused = bench::measure([&] { result = filter.apply(image, image); }, 3);
+
+        bench::report("  reused workspace", t_reused, 3*bytes, t);
+    }
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <cstdio>
+
+#include <imp/filter/median>
+
+#include "measure"
+
+
+//
+// Median filter over radius 1 - 50 on a 12 MPix 8-bit and 16-bit plane (gradient with
+// salt-and-pepper noise), single thread: the selection network (r <= 2), then the
+// histogram path whose cost should not grow with the radius
+//
+
+namespace
+{
+
+
+template <typename T>
+void run(const char* type, const imp::Matrix<T>& source)
+{
+    imp::Matrix<T> dest(source.rows(), source.cols());
+
+    const double bytes = double(source.size()*index_t(sizeof(T)));
+
+    std::printf("%s\n", type);
+
+    for (index_t radius : { 1, 2, 3, 5, 10, 20, 50 })
+    {
+        char name[64];
+
+        double t = bench::measure([&] { dest = imp::MedianFilter(radius).apply(source); }, 2);
+
+        std::snprintf(name, sizeof(name), "  radius %2d", int(radius));
+        bench::report(name, t, bytes);
+    }
+}
+
+
+}
+
+
+int main()
+{
+    imp::Matrix<uint16_t> image16(3000, 4000);
+
+    uint32_t state = 1;
+
+    // smooth 12-bit gradient with 5% salt-and-pepper noise
+    for (index_t y = 0; y < image16.rows(); ++y)
+        for (index_t x = 0; x < image16.cols(); ++x)
+        {
+            state = state*1664525u + 1013904223u;
+
+            const uint32_t noise = state >> 16;
+
+            image16(y, x) = noise < 3277 ? uint16_t(noise % 2 ? 65535 : 0) : uint16_t(16*((x + y) % 4096));
+        }
+
+    imp::Matrix<uint8_t> image8 = (image16.array() / uint16_t(256)).cast<uint8_t>();
+
+    run("uint8_t", image8);
+    run("uint16_t", image16);
+
+    return 0;
+}
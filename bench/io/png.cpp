@@ -0,0 +1,91 @@
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+#include <ex/stream/memory>
+#include <imp/io/png>
+
+#include "measure"
+
+
+//
+// PNG save/load throughput, multi-threaded encoder against single-threaded baseline
+//
+
+namespace
+{
+
+
+template <typename T>
+imp::RgbImage<T> test_image(index_t height, index_t width, T white_level)
+{
+    imp::RgbImage<T> image(height, width);
+
+    // smooth gradients + low-amplitude noise: close to camera content
+    for (index_t y = 0; y < height; ++y)
+        for (index_t x = 0; x < width; ++x)
+        {
+            uint32_t noise = uint32_t((x*73856093u) ^ (y*19349663u)) % 16u;
+
+            image.r(x, y) = T((x*white_level/width + noise) % (uint32_t(white_level) + 1));
+            image.g(x, y) = T((y*white_level/height + noise) % (uint32_t(white_level) + 1));
+            image.b(x, y) = T(((x + y)*white_level/(width + height) + noise) % (uint32_t(white_level) + 1));
+        }
+
+    return image;
+}
+
+
+template <typename T>
+void run(const char* title, index_t height, index_t width, T white_level)
+{
+    std::printf("\n%s: %ldx%ld\n", title, long(width), long(height));
+
+    auto image = test_image(height, width, white_level);
+
+    index_t capacity = image.size()*index_t(sizeof(T))*2 + 4096;
+    std::unique_ptr<uint8_t[]> data(new uint8_t[size_t(capacity)]);
+    ex::MemoryStream stream(data.get(), capacity);
+
+    double  bytes   = double(image.size() * index_t(sizeof(T)));
+    index_t threads = imp::internal::thread_count();
+
+    for (int level : { imp::png::kFast, imp::png::kDefault, imp::png::kBest })
+    {
+        imp::png::Options options;
+        options.compression = level;
+
+        options.threads = 1;
+        double t_single = bench::measure([&] { stream.seek(0); imp::png::save(stream, image, white_level, T(0), options); }, 3);
+
+        options.threads = threads;
+        double t_multi  = bench::measure([&] { stream.seek(0); imp::png::save(stream, image, white_level, T(0), options); }, 3);
+
+        char name[64];
+
+        std::snprintf(name, sizeof(name), "save: level %d, 1 thread", level);
+        bench::report(name, t_single, bytes);
+
+        std::snprintf(name, sizeof(name), "save: level %d, %ld threads", level, long(threads));
+        bench::report(name, t_multi, bytes, t_single);
+
+        std::printf("%-40s %10.2f %%\n", "compressed size", 100.0*double(stream.position())/bytes);
+    }
+
+    imp::RgbImage<T> output(height, width);
+    double t_load = bench::measure([&] { stream.seek(0); imp::png::load_into(stream, output, white_level); }, 3);
+
+    bench::report("load_into", t_load, bytes);
+}
+
+
+}
+
+
+int main()
+{
+    run<uint8_t> ("png  8-bit RGB", 2048, 3072, uint8_t(255));
+    run<uint16_t>("png 16-bit RGB", 2048, 3072, uint16_t(4095));
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include <cstdio>
+#include <memory>
+
+#include <ex/stream/memory>
+#include <imp/io/pgm>
+#include <imp/io/ppm>
+
+#include "measure"
+
+
+//
+// Sample conversion throughput of pgm/ppm load/save:
+//
+//     reference - per-sample read_byte + float math (pre-LUT implementation)
+//     lut       - block read + cached decode/encode tables
+//
+
+namespace
+{
+
+
+template <typename T>
+imp::Matrix<T> reference_pgm_load(ex::IInputStream& binary_stream, T white_level, T black_level)
+{
+    imp::internal::PnmHeader header = imp::internal::read_pnm_header(binary_stream, 0x3550, "no P5 signature");
+
+    imp::Matrix<T> image(header.height, header.width);
+
+    bool is_8bit_file = (header.max_value <= 255);
+    T    output_range = white_level - black_level;
+
+    for (index_t i = 0; i < image.size(); ++i)
+    {
+        ex::word16 r_word = imp::internal::read_word(binary_stream, is_8bit_file);
+
+        float v = float(r_word) / float(header.max_value);
+
+        image(i) = T(T(std::round(float(output_range) * v)) + black_level);
+    }
+
+    return image;
+}
+
+
+template <typename T>
+void reference_pgm_save(ex::IOutputStream& binary_stream, const imp::Matrix<T>& image, T white_level, T black_level)
+{
+    const uint16_t pgm_max = white_level <= 255 ? 255 : 65535;
+
+    binary_stream << "P5\n";
+    binary_stream << std::to_string(image.cols()) << " " << std::to_string(image.rows()) << "\n";
+    binary_stream << std::to_string(pgm_max) << "\n";
+
+    T range = white_level - black_level;
+
+    for (index_t i = 0; i < image.size(); ++i)
+    {
+        ex::range_check(image(i), black_level, white_level);
+
+        ex::word16 v = uint16_t( std::round(pgm_max * float(image(i) - black_level) / float(range)) );
+
+        if (pgm_max == 65535) binary_stream.write_byte(v.hi);
+        binary_stream.write_byte(v.low);
+    }
+}
+
+
+template <typename T>
+void run_pgm(const char* title, index_t height, index_t width, T white_level, T black_level)
+{
+    std::printf("\n%s: %ldx%ld\n", title, long(width), long(height));
+
+    imp::Matrix<T> image = imp::Matrix<T>::Random(height, width);
+    image = image.unaryExpr([&](T v) { return T(black_level + (v < 0 ? -v : v) % (white_level - black_level + 1)); });
+
+    index_t capacity = height*width*2 + 64;
+    std::unique_ptr<uint8_t[]> data(new uint8_t[size_t(capacity)]);
+    ex::MemoryStream stream(data.get(), capacity);
+
+    double bytes = double(image.size()) * sizeof(T);
+
+    double t_ref_save = bench::measure([&] { stream.seek(0); reference_pgm_save(stream, image, white_level, black_level); });
+    double t_lut_save = bench::measure([&] { stream.seek(0); imp::pgm::save(stream, image, white_level, black_level); });
+
+    double t_ref_load = bench::measure([&] { stream.seek(0); reference_pgm_load<T>(stream, white_level, black_level); });
+    double t_lut_load = bench::measure([&] { stream.seek(0); imp::pgm::load<T>(stream, white_level, black_level); });
+
+    imp::Matrix<T> output(height, width);
+    double t_into     = bench::measure([&] { stream.seek(0); imp::pgm::load_into(stream, output, white_level, black_level); });
+
+    bench::report("save: reference", t_ref_save, bytes);
+    bench::report("save: lut",       t_lut_save, bytes, t_ref_save);
+    bench::report("load: reference", t_ref_load, bytes);
+    bench::report("load: lut",       t_lut_load, bytes, t_ref_load);
+    bench::report("load_into: lut",  t_into,     bytes, t_ref_load);
+}
+
+
+template <typename T>
+void run_ppm(const char* title, index_t height, index_t width, T white_level)
+{
+    std::printf("\n%s: %ldx%ld\n", title, long(width), long(height));
+
+    imp::RgbImage<T> image(height, width);
+    image.array() = white_level / 2;
+
+    index_t capacity = 3*height*width*2 + 64;
+    std::unique_ptr<uint8_t[]> data(new uint8_t[size_t(capacity)]);
+    ex::MemoryStream stream(data.get(), capacity);
+
+    double bytes = double(image.size()) * sizeof(T);
+
+    double t_save = bench::measure([&] { stream.seek(0); imp::ppm::save(stream, image, white_level); });
+    double t_load = bench::measure([&] { stream.seek(0); imp::ppm::load<T>(stream, white_level); });
+
+    bench::report("save: lut", t_save, bytes);
+    bench::report("load: lut", t_load, bytes);
+}
+
+
+}
+
+
+int main()
+{
+    run_pgm<uint8_t> ("pgm  8-bit",              2048, 2048, uint8_t(255),   uint8_t(0));
+    run_pgm<uint16_t>("pgm 16-bit",              2048, 2048, uint16_t(4095), uint16_t(0));
+    run_pgm<int>     ("pgm 16-bit, black level", 2048, 2048, 4095,           64);
+
+    run_ppm<uint8_t> ("ppm  8-bit", 2048, 2048, uint8_t(255));
+    run_ppm<uint16_t>("ppm 16-bit", 2048, 2048, uint16_t(4095));
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <cmath>
+#include <cstdio>
+
+#include <imp/lut/lut3d>
+#include <imp/image/rgb_image>
+
+#include "measure"
+
+
+//
+// 3D LUT apply throughput: tetrahedral vs trilinear interpolation,
+// single thread against all hardware threads
+//
+
+namespace
+{
+
+
+//
+// typical grading chain: gamma decode -> 3x3 color matrix + saturation -> gamma encode
+//
+imp::Vector<float, 3> grade(const imp::Vector<float, 3>& rgb)
+{
+    imp::Vector<float, 3> linear(std::pow(rgb(0), 2.4f), std::pow(rgb(1), 2.4f), std::pow(rgb(2), 2.4f));
+
+    imp::Matrix<float, 3, 3> matrix;
+    matrix << 0.90f, 0.08f, 0.02f,
+              0.05f, 0.90f, 0.05f,
+              0.02f, 0.08f, 0.90f;
+
+    linear = matrix*linear;
+
+    float luma = 0.2126f*linear(0) + 0.7152f*linear(1) + 0.0722f*linear(2);
+
+    linear = (luma + 1.2f*(linear.array() - luma)).max(0.0f).min(1.0f).matrix();
+
+    return { std::pow(linear(0), 1/2.4f), std::pow(linear(1), 1/2.4f), std::pow(linear(2), 1/2.4f) };
+}
+
+
+template <typename T>
+imp::RgbImage<T> test_image(index_t height, index_t width, T white_level)
+{
+    imp::RgbImage<T> image(height, width);
+
+    for (index_t y = 0; y < height; ++y)
+        for (index_t x = 0; x < width; ++x)
+        {
+            uint32_t noise = uint32_t((x*73856093u) ^ (y*19349663u)) % 64u;
+
+            image.r(x, y) = T(float(x % 1024 + noise) / 1087.0f * float(white_level));
+            image.g(x, y) = T(float(y % 1024 + noise) / 1087.0f * float(white_level));
+            image.b(x, y) = T(float((x + y) % 1024 + noise) / 1087.0f * float(white_level));
+        }
+
+    return image;
+}
+
+
+template <class Interpolation, typename T>
+void run(const char* name, index_t size, const imp::RgbImage<T>& image, T white_level, double baseline)
+{
+    auto lut = imp::make_lut3d<float, Interpolation>(size, grade);
+
+    // in place: no allocation inside the measured loop, cost doesn't depend on content
+    imp::RgbImage<T> work = image;
+
+    double bytes   = double(image.size()*index_t(sizeof(T)));
+    index_t threads = imp::internal::thread_count();
+
+    double t_single = bench::measure([&] { lut.apply(ex::in_place, work, white_level, 1); }, 3);
+    double t_multi  = bench::measure([&] { lut.apply(ex::in_place, work, white_level, threads); }, 3);
+
+    char title[64];
+
+    std::snprintf(title, sizeof(title), "%s 1 thread", name);
+    bench::report(title, t_single, bytes, baseline > 0 ? baseline : t_single);
+
+    std::snprintf(title, sizeof(title), "%s %ld threads", name, long(threads));
+    bench::report(title, t_multi, bytes, baseline > 0 ? baseline : t_single);
+}
+
+
+template <typename T>
+void run_all(const char* title, index_t size, T white_level)
+{
+    std::printf("\n%s: %ld^3 LUT, 3072x2048\n", title, long(size));
+
+    auto image = test_image<T>(2048, 3072, white_level);
+
+    // direct evaluation of the transform: the cost a LUT replaces
+    imp::RgbImage<T> direct(image.height(), image.width());
+
+    double t_direct = bench::measure([&]
+    {
+        for (index_t i = 0; i < image.plane_size(); ++i)
+        {
+            auto rgb = grade(imp::Vector<float, 3>(float(image.r(i)), float(image.g(i)), float(image.b(i))) / float(white_level));
+
+            direct.r(i) = T(rgb(0)*float(white_level));
+            direct.g(i) = T(rgb(1)*float(white_level));
+            direct.b(i) = T(rgb(2)*float(white_level));
+        }
+    }, 1);
+
+    bench::report("direct transform", t_direct, double(image.size()*index_t(sizeof(T))));
+
+    run<imp::Tetrahedral>("tetrahedral", size, image, white_level, t_direct);
+    run<imp::Trilinear>  ("trilinear  ", size, image, white_level, t_direct);
+}
+
+
+}
+
+
+int main()
+{
+    run_all<float>   ("float RGB",  33, 1.0f);
+    run_all<float>   ("float RGB",  65, 1.0f);
+    run_all<uint16_t>("16-bit RGB", 65, uint16_t(65535));
+
+    return 0;
+}
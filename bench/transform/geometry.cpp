@@ -0,0 +1,94 @@
+#include <cstdio>
+
+#include <imp/filter/minmax>
+#include <imp/transform/geometry>
+
+#include "measure"
+
+
+//
+// Geometry, single thread, 12 MPix 8-bit and float planes: blocked transpose against the
+// eigen .transpose() copy, rotations, flips, in place transpose of a square matrix,
+// MinFilter (two row passes and two transposes)
+//
+
+namespace
+{
+
+
+template <typename T>
+imp::Matrix<T> test_plane(index_t rows, index_t cols)
+{
+    imp::Matrix<T> plane(rows, cols);
+
+    uint32_t state = 1;
+
+    for (index_t y = 0; y < rows; ++y)
+        for (index_t x = 0; x < cols; ++x)
+        {
+            state = state*1664525u + 1013904223u;
+            plane(y, x) = T(state >> 24);
+        }
+
+    return plane;
+}
+
+
+template <typename T>
+void run(const char* type)
+{
+    const auto plane = test_plane<T>(3000, 4000);
+    const double bytes = double(plane.size()*index_t(sizeof(T)));
+
+    imp::Matrix<T> dest;
+
+    std::printf("12 MPix %s\n", type);
+
+    double t_eigen = bench::measure([&] { dest = plane.transpose(); }, 3);
+
+    bench::report("  eigen transpose", t_eigen, bytes);
+
+    double t = bench::measure([&] { dest = imp::transpose(plane); }, 3);
+
+    bench::report("  transpose", t, bytes, t_eigen);
+
+    const char* names[] = { "  rotate 90", "  rotate 180", "  rotate 270" };
+    int i = 0;
+
+    for (auto rotation : { imp::kRotate90, imp::kRotate180, imp::kRotate270 })
+    {
+        double t_rotate = bench::measure([&] { dest = imp::rotate(plane, rotation); }, 3);
+
+        bench::report(names[i++], t_rotate, bytes, t_eigen);
+    }
+
+    double t_flip = bench::measure([&] { dest = imp::flip(plane, imp::kFlipHorizontal); }, 3);
+
+    bench::report("  flip horizontal", t_flip, bytes);
+
+    imp::Matrix<T> square = test_plane<T>(3464, 3464);
+
+    double t_in_place_eigen = bench::measure([&] { square.transposeInPlace(); }, 3);
+
+    bench::report("  eigen in place", t_in_place_eigen, bytes);
+
+    double t_in_place = bench::measure([&] { imp::transpose(ex::in_place, square); }, 3);
+
+    bench::report("  in place", t_in_place, bytes, t_in_place_eigen);
+
+    double t_min = bench::measure([&] { dest = imp::MinFilter(4).apply(plane); }, 3);
+
+    bench::report("  MinFilter radius 4", t_min, bytes);
+}
+
+
+}
+
+
+int main()
+{
+    run<uint8_t>("8-bit");
+    run<float>("float");
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <cstdio>
+
+#include <imp/transform/resize>
+
+#include "measure"
+
+
+//
+// Resize, single thread, 12 MPix 8-bit plane to preview sizes: every method, the 2x
+// reduction and enlargement paths against sizes one column off, a fresh Resize (weights
+// built) against a reused one
+//
+
+namespace
+{
+
+
+imp::Matrix<uint8_t> test_plane(index_t rows, index_t cols)
+{
+    imp::Matrix<uint8_t> plane(rows, cols);
+
+    uint32_t state = 1;
+
+    for (index_t y = 0; y < rows; ++y)
+        for (index_t x = 0; x < cols; ++x)
+        {
+            state = state*1664525u + 1013904223u;
+            plane(y, x) = uint8_t(((x / 40 + y / 30) % 2 ? 160 : 60) + (state >> 28));
+        }
+
+    return plane;
+}
+
+
+const char* method_name(imp::ResizeMethod method)
+{
+    switch (method)
+    {
+        case imp::kResizeBilinear: return "bilinear";
+        case imp::kResizeBicubic:  return "bicubic";
+        default:                   return "lanczos";
+    }
+}
+
+
+}
+
+
+int main()
+{
+    const auto plane = test_plane(3000, 4000);
+    const double bytes = double(plane.size());
+
+    imp::Matrix<uint8_t> dest;
+
+    std::printf("12 MPix to previews\n");
+
+    for (auto method : { imp::kResizeBilinear, imp::kResizeBicubic, imp::kResizeLanczos })
+        for (auto size : { std::make_pair(index_t(1500), index_t(2000)), std::make_pair(index_t(1080), index_t(1440)),
+                           std::make_pair(index_t(480), index_t(640)), std::make_pair(index_t(120), index_t(160)) })
+        {
+            imp::Resize resize(size.first, size.second, method);
+
+            char name[64];
+
+            double t = bench::measure([&] { dest = resize.apply(plane); }, 3);
+
+            std::snprintf(name, sizeof(name), "  %-8s %4d x %4d", method_name(method), int(size.second), int(size.first));
+            bench::report(name, t, bytes);
+        }
+
+    std::printf("2x paths against one column less\n");
+    {
+        const imp::Matrix<uint8_t> small = imp::Resize(1500, 2000).apply(plane);
+
+        for (auto method : { imp::kResizeBilinear, imp::kResizeBicubic, imp::kResizeLanczos })
+        {
+            imp::Resize half(1500, 2000, method);
+
+            char name[64];
+
+            double t_half = bench::measure([&] { dest = half.apply(plane); }, 3);
+
+            std::snprintf(name, sizeof(name), "  %-8s 1/2", method_name(method));
+            bench::report(name, t_half, bytes);
+
+            imp::Resize narrow(1500, 1999, method);
+
+            double t_narrow = bench::measure([&] { dest = narrow.apply(plane); }, 3);
+
+            std::snprintf(name, sizeof(name), "  %-8s 1999 x 1500", method_name(method));
+            bench::report(name, t_narrow, bytes, t_half);
+
+            imp::Resize resize(3000, 4000, method);
+
+            double t = bench::measure([&] { dest = resize.apply(small); }, 3);
+
+            std::snprintf(name, sizeof(name), "  %-8s 2x", method_name(method));
+            bench::report(name, t, bytes);
+
+            imp::Resize odd(3000, 3999, method);
+
+            double t_odd = bench::measure([&] { dest = odd.apply(small); }, 3);
+
+            std::snprintf(name, sizeof(name), "  %-8s 3999 x 3000", method_name(method));
+            bench::report(name, t_odd, bytes, t);
+        }
+    }
+
+    std::printf("12 MPix to 640 x 480, bicubic\n");
+    {
+        double t = bench::measure([&] { dest = imp::Resize(480, 640).apply(plane); }, 3);
+
+        bench::report("  fresh", t, bytes);
+
+        imp::Resize resize(480, 640);
+
+        double t_reused = bench::measure([&] { dest = resize.apply(plane); }, 3);
+
+        bench::report("  reused weights", t_reused, bytes, t);
+    }
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <imp/color/cam02>
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+RgbImage<float> test_image(index_t height, index_t width)
+{
+    RgbImage<float> image(height, width);
+
+    for (index_t y = 0; y < height; ++y)
+        for (index_t x = 0; x < width; ++x)
+        {
+            image.r(x, y) = float(x) / float(width - 1);
+            image.g(x, y) = float(y) / float(height - 1);
+            image.b(x, y) = float((x*7 + y*3) % 17) / 16.0f;
+        }
+
+    return image;
+}
+
+
+}
+
+
+TEST(cam02_test, reference_color)
+{
+    Cam02Conditions viewing;
+
+    viewing.white              = Vector<double, 3>(95.05, 100.0, 108.88);
+    viewing.adapting_luminance = 318.31;
+    viewing.background         = 20;
+
+    Cam02 cam(viewing);
+
+    Vector<double, 3> jch = cam.xyz_to_jch(Vector<double, 3>(19.01, 20.00, 21.78));
+
+    ASSERT_NEAR(jch(0), 41.731091, 1e-4);
+    ASSERT_NEAR(jch(1), 0.104708, 1e-4);
+    ASSERT_NEAR(jch(2), 219.048433, 1e-2);
+
+    Vector<double, 3> white = cam.xyz_to_jch(viewing.white);
+
+    ASSERT_NEAR(white(0), 100.0, 1e-9);
+
+    Vector<double, 3> xyz = cam.jch_to_xyz(jch);
+
+    ASSERT_NEAR(xyz(0), 19.01, 1e-6);
+    ASSERT_NEAR(xyz(1), 20.00, 1e-6);
+    ASSERT_NEAR(xyz(2), 21.78, 1e-6);
+
+    ASSERT_THROW(Cam02(Cam02Conditions{ viewing.white, 0.0, 20.0, kDimSurround }), std::logic_error);
+}
+
+
+TEST(cam02_test, float_matches_reference)
+{
+    Cam02Conditions viewing;
+    viewing.surround = kDimSurround;
+
+    Cam02 cam(viewing);
+
+    auto image = test_image(31, 57);
+    auto jab   = cam.rgb_to_jab(image, 3);
+
+    const Matrix<double, 3, 3> rgb_to_xyz = 100*internal::srgb_to_xyz();
+
+    for (index_t i = 0; i < image.plane_size(); ++i)
+    {
+        Vector<double, 3> rgb(image.r(i), image.g(i), image.b(i));
+        Vector<double, 3> jch = cam.xyz_to_jch(rgb_to_xyz*rgb);
+
+        double h = jch(2) * 3.14159265358979323846 / 180;
+
+        ASSERT_NEAR(jab.l(i), jch(0), 2e-3) << i;
+        ASSERT_NEAR(jab.a(i), jch(1)*std::cos(h), 2e-3) << i;
+        ASSERT_NEAR(jab.b(i), jch(1)*std::sin(h), 2e-3) << i;
+    }
+
+    auto rgb = cam.jab_to_rgb(jab, 2);
+
+    ASSERT_LT((rgb.array() - image.array()).abs().maxCoeff(), 1e-4f);
+}
+
+
+TEST(cam02_test, in_place_xyz)
+{
+    Cam02 cam;
+
+    auto image = test_image(17, 23);
+    auto jab   = cam.rgb_to_jab(image);
+
+    const Matrix<float, 3, 3> rgb_to_xyz = (100*internal::srgb_to_xyz()).cast<float>();
+
+    RgbImage<float> xyz(image.height(), image.width());
+
+    for (index_t i = 0; i < image.plane_size(); ++i)
+    {
+        Vector<float, 3> c = rgb_to_xyz*Vector<float, 3>(image.r(i), image.g(i), image.b(i));
+
+        xyz.r(i) = c(0);
+        xyz.g(i) = c(1);
+        xyz.b(i) = c(2);
+    }
+
+    auto work = xyz;
+
+    cam.xyz_to_jab(ex::in_place, work);
+
+    ASSERT_LT((work.array() - jab.array()).abs().maxCoeff(), 1e-3f);
+
+    cam.jab_to_xyz(ex::in_place, work);
+
+    ASSERT_LT((work.array() - xyz.array()).abs().maxCoeff(), 1e-2f);
+}
+
+
+TEST(cam02_test, srgb_lut)
+{
+    Cam02 cam;
+
+    BakeError error;
+    auto lut = cam.bake_srgb_lut(33, &error);
+
+    // the error concentrates near black, where the compression has unbounded slope
+    ASSERT_LT(error.max_error, 3.5);
+    ASSERT_LT(error.mean_error, 0.05);
+
+    RgbImage<uint8_t> image8(16, 16);
+    RgbImage<float>   linear(16, 16);
+
+    for (index_t i = 0; i < image8.plane_size(); ++i)
+    {
+        image8.r(i) = uint8_t(i);
+        image8.g(i) = uint8_t(255 - i);
+        image8.b(i) = uint8_t((i*7) % 256);
+
+        linear.r(i) = Srgb::eotf(float(image8.r(i)) / 255);
+        linear.g(i) = Srgb::eotf(float(image8.g(i)) / 255);
+        linear.b(i) = Srgb::eotf(float(image8.b(i)) / 255);
+    }
+
+    LabImage<float> jab(16, 16);
+
+    lut.apply(image8, jab);
+
+    auto direct = cam.rgb_to_jab(linear);
+
+    ASSERT_LT((jab.array() - direct.array()).abs().maxCoeff(), 3.5f);
+    ASSERT_LT((jab.array() - direct.array()).abs().mean(), 0.05f);
+
+    LabImage<float> wrong(8, 16);
+
+    ASSERT_THROW(lut.apply(image8, wrong), std::logic_error);
+}
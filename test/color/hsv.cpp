@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <imp/color/hsv>
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+RgbImage<float> test_image(index_t height, index_t width)
+{
+    RgbImage<float> image(height, width);
+
+    for (index_t y = 0; y < height; ++y)
+        for (index_t x = 0; x < width; ++x)
+        {
+            image.r(x, y) = float(x) / float(width - 1);
+            image.g(x, y) = float(y) / float(height - 1);
+            image.b(x, y) = float((x*7 + y*3) % 17) / 16.0f;
+        }
+
+    return image;
+}
+
+
+RgbImage<uint8_t> test_image8(index_t height, index_t width)
+{
+    RgbImage<uint8_t> image(height, width);
+
+    for (index_t y = 0; y < height; ++y)
+        for (index_t x = 0; x < width; ++x)
+        {
+            image.r(x, y) = uint8_t((x*37 + y) % 256);
+            image.g(x, y) = uint8_t((y*53 + x*3) % 256);
+            image.b(x, y) = uint8_t((x*y + 11) % 256);
+        }
+
+    return image;
+}
+
+
+// textbook conversion, branches on the maximal channel
+void reference(double r, double g, double b, double& h, double& s, double& v, double& l, double& sl)
+{
+    double hi = std::max({ r, g, b });
+    double lo = std::min({ r, g, b });
+    double c  = hi - lo;
+
+    h = 0;
+
+    if (c > 0)
+    {
+        if      (hi == r) h = std::fmod((g - b) / c + 6, 6);
+        else if (hi == g) h = (b - r) / c + 2;
+        else              h = (r - g) / c + 4;
+    }
+
+    h  = h / 6;
+    v  = hi;
+    s  = hi > 0 ? c / hi : 0;
+    l  = (hi + lo) / 2;
+    sl = c > 0 ? c / (1 - std::abs(2*l - 1)) : 0;
+}
+
+
+double hue_distance(double a, double b)
+{
+    double d = std::abs(a - b);
+    return std::min(d, 1 - d);
+}
+
+
+}
+
+
+TEST(hsv_test, primary_colors)
+{
+    RgbImage<float> image(1, 4);
+
+    image.r(0) = 1; image.g(0) = 0; image.b(0) = 0;
+    image.r(1) = 0; image.g(1) = 1; image.b(1) = 0;
+    image.r(2) = 0; image.g(2) = 0; image.b(2) = 0.5f;
+    image.r(3) = 0.25f; image.g(3) = 0.25f; image.b(3) = 0.25f;
+
+    auto hsv = rgb_to_hsv(image);
+
+    ASSERT_FLOAT_EQ(hsv.h(0), 0.0f);
+    ASSERT_FLOAT_EQ(hsv.h(1), 1/3.0f);
+    ASSERT_FLOAT_EQ(hsv.h(2), 2/3.0f);
+    ASSERT_FLOAT_EQ(hsv.s(2), 1.0f);
+    ASSERT_FLOAT_EQ(hsv.v(2), 0.5f);
+
+    // gray
+    ASSERT_EQ(hsv.h(3), 0.0f);
+    ASSERT_EQ(hsv.s(3), 0.0f);
+    ASSERT_FLOAT_EQ(hsv.v(3), 0.25f);
+
+    auto hsl = rgb_to_hsl(image);
+
+    ASSERT_FLOAT_EQ(hsl.l(0), 0.5f);
+    ASSERT_FLOAT_EQ(hsl.s(0), 1.0f);
+    ASSERT_FLOAT_EQ(hsl.l(2), 0.25f);
+    ASSERT_FLOAT_EQ(hsl.s(2), 1.0f);
+}
+
+
+TEST(hsv_test, matches_reference)
+{
+    auto image = test_image(37, 101);
+
+    auto hsv = rgb_to_hsv(image);
+    auto hsl = rgb_to_hsl(image);
+
+    for (index_t i = 0; i < image.plane_size(); ++i)
+    {
+        double h, s, v, l, sl;
+        reference(image.r(i), image.g(i), image.b(i), h, s, v, l, sl);
+
+        ASSERT_LT(hue_distance(hsv.h(i), h), 1e-6) << i;
+        ASSERT_NEAR(hsv.s(i), s, 1e-6) << i;
+        ASSERT_NEAR(hsv.v(i), v, 1e-6) << i;
+
+        ASSERT_EQ(hsl.h(i), hsv.h(i));
+        ASSERT_NEAR(hsl.s(i), sl, 1e-5) << i;
+        ASSERT_NEAR(hsl.l(i), l, 1e-6) << i;
+
+        ASSERT_GE(hsv.h(i), 0.0f);
+        ASSERT_LT(hsv.h(i), 1.0f);
+    }
+}
+
+
+TEST(hsv_test, round_trip)
+{
+    auto image = test_image(37, 101);
+
+    auto rgb1 = hsv_to_rgb(rgb_to_hsv(image));
+    auto rgb2 = hsl_to_rgb(rgb_to_hsl(image));
+
+    ASSERT_LT((rgb1.array() - image.array()).abs().maxCoeff(), 1e-5f);
+    ASSERT_LT((rgb2.array() - image.array()).abs().maxCoeff(), 1e-5f);
+}
+
+
+TEST(hsv_test, fixed_point)
+{
+    auto image = test_image8(29, 131);
+
+    auto hsv = rgb_to_hsv(image);
+    auto hsl = rgb_to_hsl(image);
+
+    for (index_t i = 0; i < image.plane_size(); ++i)
+    {
+        double h, s, v, l, sl;
+        reference(image.r(i) / 255.0, image.g(i) / 255.0, image.b(i) / 255.0, h, s, v, l, sl);
+
+        ASSERT_LE(hue_distance(hsv.h(i) / 256.0, h) * 256, 1.0) << i;
+        ASSERT_LE(std::abs(hsv.s(i) - s*255), 1.0) << i;
+        ASSERT_EQ(hsv.v(i), std::max({ image.r(i), image.g(i), image.b(i) })) << i;
+
+        ASSERT_LE(std::abs(hsl.s(i) - sl*255), 1.0) << i;
+        ASSERT_LE(std::abs(hsl.l(i) - l*255), 0.5 + 1e-9) << i; // ties round up
+    }
+
+    // inverse is float rounded: error of 8-bit hue/saturation steps only
+    auto rgb1 = hsv_to_rgb(hsv);
+    auto rgb2 = hsl_to_rgb(hsl);
+
+    ASSERT_LE((rgb1.array().cast<int>() - image.array().cast<int>()).abs().maxCoeff(), 4);
+    ASSERT_LE((rgb2.array().cast<int>() - image.array().cast<int>()).abs().maxCoeff(), 4);
+}
+
+
+TEST(hsv_test, in_place_and_threads)
+{
+    auto image = test_image(83, 67);
+
+    auto hsv = rgb_to_hsv(image, 4);
+    auto copy = image;
+
+    rgb_to_hsv(ex::in_place, copy);
+
+    ASSERT_TRUE(copy.array().isApprox(hsv.array(), 0.0f));
+
+    hsv_to_rgb(ex::in_place, copy, 3);
+
+    ASSERT_LT((copy.array() - image.array()).abs().maxCoeff(), 1e-5f);
+
+    auto image8 = test_image8(83, 67);
+    auto hsl8 = rgb_to_hsl(image8, 4);
+
+    rgb_to_hsl(ex::in_place, image8);
+
+    ASSERT_TRUE((image8.array() == hsl8.array()).all());
+}
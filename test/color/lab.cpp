@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <imp/color/lab>
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+RgbImage<float> test_image(index_t height, index_t width)
+{
+    RgbImage<float> image(height, width);
+
+    for (index_t y = 0; y < height; ++y)
+        for (index_t x = 0; x < width; ++x)
+        {
+            image.r(x, y) = float(x) / float(width - 1);
+            image.g(x, y) = float(y) / float(height - 1);
+            image.b(x, y) = float((x*7 + y*3) % 17) / 16.0f;
+        }
+
+    return image;
+}
+
+
+}
+
+
+TEST(lab_test, reference_colors)
+{
+    Vector<double, 3> white = rgb_to_lab(Vector<double, 3>(1, 1, 1));
+
+    ASSERT_NEAR(white(0), 100.0, 1e-3);
+    ASSERT_NEAR(white(1), 0.0, 1e-3);
+    ASSERT_NEAR(white(2), 0.0, 1e-3);
+
+    // linear sRGB red
+    Vector<double, 3> red = rgb_to_lab(Vector<double, 3>(1, 0, 0));
+
+    ASSERT_NEAR(red(0), 53.2408, 1e-3);
+    ASSERT_NEAR(red(1), 80.0925, 1e-3);
+    ASSERT_NEAR(red(2), 67.2032, 1e-3);
+
+    // dark colors use the linear segment
+    Vector<double, 3> dark = rgb_to_lab(Vector<double, 3>(0.001, 0.001, 0.001));
+
+    ASSERT_NEAR(dark(0), 0.001*internal::kLabKappa, 1e-3);
+
+    Vector<double, 3> back = lab_to_rgb(red);
+
+    ASSERT_NEAR(back(0), 1.0, 1e-9);
+    ASSERT_NEAR(back(1), 0.0, 1e-9);
+}
+
+
+TEST(lab_test, fast_matches_reference)
+{
+    auto image = test_image(23, 41);
+    auto lab   = rgb_to_lab(image, 3);
+
+    for (index_t i = 0; i < image.plane_size(); ++i)
+    {
+        Vector<double, 3> exact = rgb_to_lab(Vector<double, 3>(image.r(i), image.g(i), image.b(i)));
+
+        ASSERT_NEAR(lab.l(i), exact(0), 1e-4);
+        ASSERT_NEAR(lab.a(i), exact(1), 5e-4); // 500*(fx - fy) scales float rounding
+        ASSERT_NEAR(lab.b(i), exact(2), 5e-4);
+
+        Vector<float, 3> single = rgb_to_lab(Vector<float, 3>(image.r(i), image.g(i), image.b(i)));
+
+        ASSERT_EQ(single(0), lab.l(i));
+        ASSERT_EQ(single(2), lab.b(i));
+    }
+}
+
+
+TEST(lab_test, round_trip)
+{
+    auto image = test_image(17, 130);
+    auto rgb   = lab_to_rgb(rgb_to_lab(image), 2);
+
+    for (index_t i = 0; i < image.size(); ++i)
+    {
+        ASSERT_NEAR(rgb.data()[i], image.data()[i], 1e-5f);
+    }
+}
+
+
+TEST(lab_test, in_place)
+{
+    auto image = test_image(9, 70);
+    auto lab   = rgb_to_lab(image);
+
+    RgbImage<float> work = image;
+
+    rgb_to_lab(ex::in_place, work, 4);
+
+    for (index_t i = 0; i < image.size(); ++i)
+    {
+        ASSERT_EQ(work.data()[i], lab.data()[i]);
+    }
+
+    lab_to_rgb(ex::in_place, work);
+
+    for (index_t i = 0; i < image.size(); ++i)
+    {
+        ASSERT_NEAR(work.data()[i], image.data()[i], 1e-5f);
+    }
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+
+#include <imp/color/transfer>
+#include <imp/image/rgb_image>
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+int64_t ulp_distance(float a, float b)
+{
+    return std::llabs(int64_t(internal::float_bits(a)) - int64_t(internal::float_bits(b)));
+}
+
+
+//
+// max ulp error over every 331st float in [0, 1] for outputs >= min_output
+//
+template <class Fast, class Exact>
+int64_t max_ulp(Fast fast, Exact exact, float min_output = 0)
+{
+    int64_t worst = 0;
+
+    for (uint32_t bits = 0; bits <= 0x3f800000u; bits += 331)
+    {
+        float x = internal::bits_float(bits);
+        float r = float(exact(double(x)));
+
+        if (r >= min_output) worst = std::max(worst, ulp_distance(fast(x), r));
+    }
+
+    return worst;
+}
+
+
+}
+
+
+TEST(transfer_test, fast_pow)
+{
+    ASSERT_EQ(internal::fast_pow(0.0f, 2.4f), 0.0f);
+    ASSERT_EQ(internal::fast_pow(-1.0f, 2.4f), 0.0f);
+    ASSERT_EQ(internal::fast_pow(1.0f, 2.4f), 1.0f);
+    ASSERT_EQ(internal::fast_pow(4.0f, 0.5f), 2.0f);
+
+    ASSERT_NEAR(internal::fast_log2(10.0f), std::log2(10.0f), 1e-6f);
+    ASSERT_NEAR(internal::fast_exp2(-3.3f), std::exp2(-3.3f), 1e-7f);
+}
+
+
+TEST(transfer_test, ulp_error)
+{
+    ASSERT_LE(max_ulp(Srgb::eotf,  Srgb::eotf_exact),  15);
+    ASSERT_LE(max_ulp(Srgb::oetf,  Srgb::oetf_exact),  8);
+    ASSERT_LE(max_ulp(Bt709::eotf, Bt709::eotf_exact), 11);
+    ASSERT_LE(max_ulp(Bt709::oetf, Bt709::oetf_exact), 8);
+    ASSERT_LE(max_ulp(Bt601::oetf, Bt601::oetf_exact), 8);
+
+    ASSERT_LE(max_ulp(St2084::eotf, St2084::eotf_exact, 1e-4f), 982);
+    ASSERT_LE(max_ulp(St2084::oetf, St2084::oetf_exact, 1e-4f), 258);
+}
+
+
+TEST(transfer_test, reference_values)
+{
+    ASSERT_NEAR(Srgb::eotf_exact(0.5), 0.214041, 1e-6);
+    ASSERT_NEAR(Srgb::oetf_exact(0.214041), 0.5, 1e-6);
+    ASSERT_NEAR(Bt709::oetf_exact(0.018053968510807), 0.081242858, 1e-8);
+    ASSERT_NEAR(Bt709::eotf_exact(Bt709::oetf_exact(0.3)), 0.3, 1e-12);
+
+    // PQ: 100 cd/m^2 is signal 0.508078
+    ASSERT_NEAR(St2084::oetf_exact(0.01), 0.508078, 1e-6);
+    ASSERT_NEAR(St2084::eotf_exact(1.0), 1.0, 1e-12);
+    ASSERT_EQ(St2084::eotf_exact(0.0), 0.0);
+
+    // clamping
+    ASSERT_EQ(Srgb::eotf(-0.5f), 0.0f);
+    ASSERT_EQ(Srgb::eotf(2.0f), 1.0f);
+    ASSERT_EQ(St2084::eotf(0.0f), 0.0f);
+}
+
+
+TEST(transfer_test, apply_matrix)
+{
+    Matrix<float> signal(4, 37);
+
+    for (index_t i = 0; i < signal.size(); ++i) signal(i) = float(i) / float(signal.size() - 1);
+
+    Matrix<float> linear = eotf<Srgb>(signal, 2);
+
+    ASSERT_EQ(linear.rows(), 4);
+    ASSERT_EQ(linear(2, 5), Srgb::eotf(signal(2, 5)));
+
+    // in place on a block and on a transposed (strided) view
+    Matrix<float> work = signal;
+    oetf<Bt709>(ex::in_place, work.block(1, 3, 2, 10));
+
+    ASSERT_EQ(work(1, 3), Bt709::oetf(signal(1, 3)));
+    ASSERT_EQ(work(0, 3), signal(0, 3));
+
+    Matrix<float> column = signal;
+    eotf<St2084>(ex::in_place, column.transpose(), 3);
+
+    ASSERT_EQ(column(3, 36), St2084::eotf(signal(3, 36)));
+}
+
+
+TEST(transfer_test, apply_image)
+{
+    RgbImage<float> image(6, 9);
+
+    for (index_t i = 0; i < image.size(); ++i) image.data()[i] = float(i) / float(image.size());
+
+    RgbImage<float> linear = eotf<Srgb>(image);
+    RgbImage<float> round  = linear;
+
+    oetf<Srgb>(ex::in_place, round, 2);
+
+    for (index_t i = 0; i < image.size(); ++i)
+    {
+        ASSERT_EQ(linear.data()[i], Srgb::eotf(image.data()[i]));
+        ASSERT_NEAR(round.data()[i], image.data()[i], 2e-6f);
+    }
+
+    eotf<Srgb>(ex::in_place, image.plane(2));
+
+    ASSERT_EQ(image.b(4, 3), linear.b(4, 3));
+    ASSERT_NE(image.r(4, 3), linear.r(4, 3));
+}
@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <imp/color/yuv>
+#include <imp/image/rgb_image>
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+template <typename T>
+RgbImage<T> test_image(index_t height, index_t width, float white)
+{
+    RgbImage<T> image(height, width);
+
+    for (index_t y = 0; y < height; ++y)
+        for (index_t x = 0; x < width; ++x)
+        {
+            image.r(x, y) = T(white * float(x) / float(width));
+            image.g(x, y) = T(white * float(y) / float(height));
+            image.b(x, y) = T(white * float((x + y) % 8) / 8.0f);
+        }
+
+    return image;
+}
+
+
+}
+
+
+TEST(yuv_test, reference_levels)
+{
+    RgbImage<uint8_t> image(1, 3);
+
+    image.r(0, 0) = 255, image.g(0, 0) = 255, image.b(0, 0) = 255;
+    image.r(1, 0) = 0,   image.g(1, 0) = 0,   image.b(1, 0) = 0;
+    image.r(2, 0) = 255, image.g(2, 0) = 0,   image.b(2, 0) = 0;
+
+    Matrix<uint8_t> y(1, 3), u(1, 3), v(1, 3);
+
+    rgb_to_yuv<Bt709>(rgb_view(image), yuv_view(y, u, v));
+
+    ASSERT_EQ(y(0, 0), 235);
+    ASSERT_EQ(u(0, 0), 128);
+    ASSERT_EQ(v(0, 0), 128);
+
+    ASSERT_EQ(y(0, 1), 16);
+    ASSERT_EQ(u(0, 1), 128);
+
+    // BT.709 red: Y = 16 + 219*0.2126, Cb = 128 - 224*0.2126/1.8556, Cr = 240
+    ASSERT_EQ(y(0, 2), 63);
+    ASSERT_EQ(u(0, 2), 102);
+    ASSERT_EQ(v(0, 2), 240);
+
+    rgb_to_yuv<Bt601>(rgb_view(image), yuv_view(y, u, v), kFullRange);
+
+    ASSERT_EQ(y(0, 0), 255);
+    ASSERT_EQ(y(0, 2), 76); // 0.299*255
+    ASSERT_EQ(v(0, 2), 255);
+}
+
+
+TEST(yuv_test, chroma_average)
+{
+    auto image = test_image<uint8_t>(6, 10, 255);
+
+    Matrix<uint8_t> y(6, 10), u(6, 10), v(6, 10);
+    std::vector<uint8_t> frame(size_t(i420_size(6, 10)));
+
+    rgb_to_yuv(rgb_view(image), yuv_view(y, u, v));
+    rgb_to_yuv(rgb_view(image), i420_view(frame.data(), 6, 10));
+
+    auto i420 = i420_view(frame.data(), 6, 10);
+
+    ASSERT_EQ(i420.u.rows(), 3);
+    ASSERT_EQ(i420.u.cols(), 5);
+
+    for (index_t cy = 0; cy < 3; ++cy)
+        for (index_t cx = 0; cx < 5; ++cx)
+        {
+            int su = u(2*cy, 2*cx) + u(2*cy, 2*cx + 1) + u(2*cy + 1, 2*cx) + u(2*cy + 1, 2*cx + 1);
+            int sv = v(2*cy, 2*cx) + v(2*cy, 2*cx + 1) + v(2*cy + 1, 2*cx) + v(2*cy + 1, 2*cx + 1);
+
+            ASSERT_LE(std::abs(4*int(i420.u(cy, cx)) - su), 4);
+            ASSERT_LE(std::abs(4*int(i420.v(cy, cx)) - sv), 4);
+        }
+
+    ASSERT_TRUE(i420.y == y);
+}
+
+
+TEST(yuv_test, nv12_and_i420)
+{
+    auto image = test_image<uint8_t>(7, 9, 255); // odd sizes
+
+    std::vector<uint8_t> i420(size_t(i420_size(7, 9)));
+    std::vector<uint8_t> nv12(size_t(nv12_size(7, 9)));
+
+    rgb_to_yuv(rgb_view(image), i420_view(i420.data(), 7, 9));
+    rgb_to_yuv(rgb_view(image), nv12_view(nv12.data(), 7, 9), kLimitedRange, 3);
+
+    auto a = i420_view(i420.data(), 7, 9);
+    auto b = nv12_view(nv12.data(), 7, 9);
+
+    ASSERT_TRUE(a.y == b.y);
+    ASSERT_TRUE(a.u == b.u);
+    ASSERT_TRUE(a.v == b.v);
+
+    // interleaved layout
+    ASSERT_EQ(nv12[size_t(7*9 + 1)], a.v(0, 0));
+    ASSERT_EQ(nv12[size_t(7*9 + 2)], a.u(0, 1));
+}
+
+
+TEST(yuv_test, round_trip)
+{
+    // 8-bit 4:4:4 full range: rounding only
+    auto image = test_image<uint8_t>(16, 24, 255);
+
+    Matrix<uint8_t> y(16, 24), u(16, 24), v(16, 24);
+    RgbImage<uint8_t> back(16, 24);
+
+    rgb_to_yuv<Bt601>(rgb_view(image), yuv_view(y, u, v), kFullRange);
+    yuv_to_rgb<Bt601>(yuv_view(y, u, v), rgb_view(back), kFullRange, 2);
+
+    for (index_t i = 0; i < image.size(); ++i)
+    {
+        ASSERT_LE(std::abs(int(back.data()[i]) - int(image.data()[i])), 2);
+    }
+
+    // float 4:2:2: exact for colors constant over pixel pairs
+    RgbImage<float> flat(4, 8);
+
+    for (index_t i = 0; i < flat.size(); ++i) flat.data()[i] = float((i/2) % 5) / 4.0f;
+
+    std::vector<float> frame(size_t(i422_size(4, 8)));
+    RgbImage<float> result(4, 8);
+
+    rgb_to_yuv(rgb_view(flat), i422_view(frame.data(), 4, 8));
+    yuv_to_rgb(i422_view(static_cast<const float*>(frame.data()), 4, 8), rgb_view(result));
+
+    for (index_t i = 0; i < flat.size(); ++i)
+    {
+        ASSERT_NEAR(result.data()[i], flat.data()[i], 1e-5f);
+    }
+
+    // 16-bit 4:2:0: smooth image survives subsampling
+    auto deep = test_image<uint16_t>(32, 32, 65535);
+    RgbImage<uint16_t> deep_back(32, 32);
+
+    std::vector<uint16_t> deep_frame(size_t(i420_size(32, 32)));
+
+    rgb_to_yuv(rgb_view(deep), i420_view(deep_frame.data(), 32, 32));
+    yuv_to_rgb(i420_view(deep_frame.data(), 32, 32), rgb_view(deep_back));
+
+    for (index_t i = 0; i < deep.plane_size(); ++i)
+    {
+        ASSERT_LE(std::abs(int(deep_back.g(i)) - int(deep.g(i))), 4096);
+    }
+}
+
+
+TEST(yuv_test, saturated_32bit)
+{
+    // Y and V at the limit: red overshoots and saturates below 2^32 instead of wrapping
+    Matrix<uint32_t> y = Matrix<uint32_t>::Constant(2, 4, std::numeric_limits<uint32_t>::max());
+    Matrix<uint32_t> u = Matrix<uint32_t>::Constant(2, 4, 1u << 31);
+    Matrix<uint32_t> v = y;
+
+    RgbImage<uint32_t> rgb(2, 4);
+
+    yuv_to_rgb<Bt601>(yuv_view(y, u, v), rgb_view(rgb), kFullRange);
+
+    for (index_t i = 0; i < rgb.plane_size(); ++i)
+    {
+        ASSERT_EQ(rgb.r(i), 4294967040u);
+        ASSERT_GE(rgb.b(i), 4294960000u);
+    }
+}
+
+
+TEST(yuv_test, strips)
+{
+    auto image = test_image<uint8_t>(12, 10, 255);
+
+    std::vector<uint8_t> whole(size_t(i420_size(12, 10)));
+    std::vector<uint8_t> top(size_t(i420_size(6, 10)));
+    std::vector<uint8_t> bottom(size_t(i420_size(6, 10)));
+
+    rgb_to_yuv(rgb_view(image), i420_view(whole.data(), 12, 10));
+    rgb_to_yuv(rgb_view(image, 0, 0, 6, 10), i420_view(top.data(), 6, 10));
+    rgb_to_yuv(rgb_view(image, 6, 0, 6, 10), i420_view(bottom.data(), 6, 10));
+
+    auto w = i420_view(whole.data(), 12, 10);
+    auto b = i420_view(bottom.data(), 6, 10);
+
+    ASSERT_TRUE(w.y.bottomRows(6) == b.y);
+    ASSERT_TRUE(w.u.bottomRows(3) == b.u);
+
+    // region rows/columns are strided views of the image
+    RgbImage<uint8_t> decoded(12, 10);
+    decoded.plane(0).setZero();
+
+    yuv_to_rgb(i420_view(bottom.data(), 6, 10), rgb_view(decoded, 6, 0, 6, 10));
+
+    ASSERT_EQ(decoded.r(3, 0), 0);
+    ASSERT_NE(decoded.r(3, 11), 0);
+}
+
+
+TEST(yuv_test, invalid_sizes)
+{
+    auto image = test_image<uint8_t>(8, 8, 255);
+
+    Matrix<uint8_t> y(8, 8), u(3, 4), v(4, 4);
+
+    ASSERT_THROW(rgb_to_yuv(rgb_view(image), yuv_view(y, u, v)), std::logic_error);
+
+    u.resize(4, 4);
+    y.resize(8, 7);
+
+    ASSERT_THROW(rgb_to_yuv(rgb_view(image), yuv_view(y, u, v)), std::logic_error);
+    ASSERT_THROW(rgb_view(image, 4, 0, 5, 8), std::logic_error);
+}
@@ -63,3 +63,19 @@ TEST(traits, eigen_transpose)
     using T6 = typename eigen_transpose<Eigen::Block<Matrix<int>>>::type;
     static_assert(std::is_same<T6, Matrix<int>>::value, "Block<Matrix<int> decay");
 }
+
+
+TEST(traits, eigen_rotate)
+{
+    using T1 = typename eigen_rotate<Matrix<int, 3, 3>>::type;
+    static_assert(std::is_same<T1, Matrix<int, 3, 3>>::value, "Matrix<T, 3, 3> rotate");
+
+    using T2 = typename eigen_rotate<Matrix<int, 3, 4>>::type;
+    static_assert(std::is_same<T2, Matrix<int>>::value, "Matrix<T, 3, 4> rotate");
+
+    using T3 = typename eigen_rotate<Eigen::Block<Array<int, 3, 4>>>::type;
+    static_assert(std::is_same<T3, Array<int>>::value, "Block<Array<int, 3, 4> rotate");
+
+    using T4 = typename eigen_rotate<Eigen::Transpose<Array<int>>>::type;
+    static_assert(std::is_same<T4, Array<int>>::value, "Transpose<Array<int>> rotate");
+}
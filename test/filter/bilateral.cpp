@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <imp/common/matrix>
+#include <imp/filter/bilateral>
+#include <imp/image/rgb_image>
+
+#include "fixture"
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+// brute force in double, window of radius ceil(3*ss) clipped by the borders
+Matrix<double> naive_bilateral(const Matrix<float>& matrix, double ss, double sr)
+{
+    const index_t radius = index_t(std::ceil(3*ss));
+
+    Matrix<double> result(matrix.rows(), matrix.cols());
+
+    for (index_t y = 0; y < matrix.rows(); ++y)
+        for (index_t x = 0; x < matrix.cols(); ++x)
+        {
+            double sum = 0, weight = 0;
+
+            for (index_t v = std::max<index_t>(y - radius, 0); v <= std::min(y + radius, matrix.rows() - 1); ++v)
+                for (index_t u = std::max<index_t>(x - radius, 0); u <= std::min(x + radius, matrix.cols() - 1); ++u)
+                {
+                    double d = double(matrix(v, u) - matrix(y, x));
+                    double w = std::exp(-0.5*double((v - y)*(v - y) + (u - x)*(u - x)) / (ss*ss) - 0.5*d*d / (sr*sr));
+
+                    sum    += w*double(matrix(v, u));
+                    weight += w;
+                }
+
+            result(y, x) = sum / weight;
+        }
+
+    return result;
+}
+
+
+}
+
+
+TEST(bilateral_filter, constant)
+{
+    for (auto mode : { kBilateralGrid, kBilateralExact })
+    {
+        Matrix<float> test = Matrix<float>::Constant(30, 20, 100.0f);
+
+        ASSERT_LT((BilateralFilter(4, 10, mode).apply(test).array() - 100.0f).abs().maxCoeff(), 1e-3f) << mode;
+
+        Matrix<uint8_t> test8 = Matrix<uint8_t>::Constant(30, 20, 200);
+
+        ASSERT_TRUE(BilateralFilter(4, 10, mode).apply(test8) == test8) << mode;
+    }
+}
+
+
+TEST(bilateral_filter, exact_matches_naive)
+{
+    auto source = fixture::edge_matrix<float>(23, 37);
+
+    for (double ss : { 1.0, 2.5 })
+        for (double sr : { 5.0, 40.0 })
+        {
+            auto result = BilateralFilter(ss, sr, kBilateralExact).apply(source, 3);
+
+            ASSERT_LT((result.cast<double>() - naive_bilateral(source, ss, sr)).cwiseAbs().maxCoeff(), 1e-3) << ss << ", " << sr;
+        }
+}
+
+
+TEST(bilateral_filter, grid_approximates_exact)
+{
+    auto source = fixture::edge_matrix<float>(96, 128);
+
+    for (double ss : { 4.0, 8.0 })
+    {
+        auto exact = BilateralFilter(ss, 15, kBilateralExact).apply(source);
+        auto grid  = BilateralFilter(ss, 15).apply(source);
+
+        // the step of 150 survives, the texture of the sides is smoothed out
+        ASSERT_LT((grid - exact).cwiseAbs().mean(), 1.5f) << ss;
+        ASSERT_LT((grid - exact).cwiseAbs().maxCoeff(), 8.0f) << ss;
+
+        ASSERT_GT(grid.col(64).minCoeff() - grid.col(63).maxCoeff(), 100.0f) << ss;
+    }
+}
+
+
+TEST(bilateral_filter, in_place_and_threads)
+{
+    for (auto mode : { kBilateralGrid, kBilateralExact })
+    {
+        auto source   = fixture::edge_matrix<uint8_t>(57, 41);
+        auto expected = BilateralFilter(4, 12, mode).apply(source);
+
+        for (index_t threads : { 1, 2, 4 })
+        {
+            auto copy = source;
+
+            BilateralFilter(4, 12, mode).apply(ex::in_place, copy, threads);
+
+            ASSERT_TRUE(copy == expected) << mode << ", " << threads;
+            ASSERT_TRUE(BilateralFilter(4, 12, mode).apply(source, threads) == expected) << mode << ", " << threads;
+        }
+
+        Matrix<uint8_t> transposed = BilateralFilter(4, 12, mode).apply(source.transpose());
+        Matrix<uint8_t> expected_t = BilateralFilter(4, 12, mode).apply(Matrix<uint8_t>(source.transpose()));
+
+        ASSERT_TRUE(transposed == expected_t) << mode;
+    }
+
+    ASSERT_THROW(BilateralFilter(0, 1), std::logic_error);
+    ASSERT_THROW(BilateralFilter(1, 0), std::logic_error);
+}
+
+
+TEST(bilateral_filter, invalid_guide)
+{
+    const float kNonFinite[] = { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(),
+                                 -std::numeric_limits<float>::infinity() };
+
+    for (auto mode : { kBilateralGrid, kBilateralExact })
+        for (float sample : kNonFinite)
+        {
+            auto source = fixture::edge_matrix<float>(20, 30);
+
+            source(7, 11) = sample;
+
+            ASSERT_THROW(BilateralFilter(4, 10, mode).apply(source), std::logic_error) << mode << ", " << sample;
+
+            RgbImage<float> image(20, 30);
+
+            image.plane(0) = fixture::edge_matrix<float>(20, 30);
+            image.plane(1) = image.plane(0);
+            image.plane(2) = source;
+
+            ASSERT_THROW(BilateralFilter(4, 10, mode).apply(image), std::logic_error) << mode << ", " << sample;
+        }
+
+    // range planes of a tiny range sigma over a wide float range
+    Matrix<float> wide = fixture::edge_matrix<float>(20, 30);
+
+    wide(0, 0) = 1e30f;
+
+    ASSERT_THROW(BilateralFilter(4, 1e-3).apply(wide), std::logic_error);
+}
+
+
+TEST(bilateral_filter, luminance_guided_rgb)
+{
+    auto plane = fixture::edge_matrix<float>(40, 56);
+
+    for (auto mode : { kBilateralGrid, kBilateralExact })
+    {
+        // gray: the luminance is the samples, every plane is filtered like the matrix
+        RgbImage<float> gray(40, 56);
+
+        for (index_t c = 0; c < 3; ++c) gray.plane(c) = plane;
+
+        auto result   = BilateralFilter(4, 15, mode).apply(gray, 2);
+        auto expected = BilateralFilter(4, 15, mode).apply(plane);
+
+        for (index_t c = 0; c < 3; ++c)
+            ASSERT_LT((Matrix<float>(result.plane(c)) - expected).cwiseAbs().maxCoeff(), 0.1f) << mode << ", " << c;
+
+        // a chroma edge without a luminance edge is smoothed
+        RgbImage<uint8_t> image(40, 56);
+
+        for (index_t y = 0; y < 40; ++y)
+            for (index_t x = 0; x < 56; ++x)
+            {
+                image.r(x, y) = uint8_t(x < 28 ? 200 : 100);
+                image.g(x, y) = uint8_t(x < 28 ? 100 : 141);  // 0.2126*r + 0.7152*g + 0.0722*b ~ equal sides
+                image.b(x, y) = uint8_t(100);
+            }
+
+        auto copy = image;
+
+        BilateralFilter(4, 15, mode).apply(ex::in_place, copy);
+
+        ASSERT_LT(int(copy.r(28, 20)) - int(copy.r(27, 20)), 0) << mode;
+        ASSERT_GT(int(copy.r(27, 20)), 100) << mode;
+        ASSERT_LT(int(copy.r(27, 20)), 200) << mode;
+        ASSERT_LT(std::abs(int(copy.r(27, 20)) - int(copy.r(28, 20))), 40) << mode;
+    }
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <imp/common/matrix>
+#include <imp/filter/box>
+
+#include "fixture"
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+// mean over the window clipped by the borders
+template <typename T>
+Matrix<double> naive_box(const Matrix<T>& matrix, index_t radius)
+{
+    Matrix<double> result(matrix.rows(), matrix.cols());
+
+    for (index_t y = 0; y < matrix.rows(); ++y)
+        for (index_t x = 0; x < matrix.cols(); ++x)
+        {
+            index_t top    = std::max<index_t>(y - radius, 0);
+            index_t left   = std::max<index_t>(x - radius, 0);
+            index_t bottom = std::min(y + radius, matrix.rows() - 1);
+            index_t right  = std::min(x + radius, matrix.cols() - 1);
+
+            result(y, x) = matrix.block(top, left, bottom - top + 1, right - left + 1).template cast<double>().mean();
+        }
+
+    return result;
+}
+
+
+}
+
+
+TEST(box_filter, radius_1)
+{
+    Matrix<int> test({
+        { 9, 0, 0, 0 },
+        { 0, 0, 0, 0 },
+        { 0, 0, 9, 0 },
+    });
+
+    Matrix<int> expected({
+        { 2, 2, 0, 0 },
+        { 2, 2, 1, 2 },
+        { 0, 2, 2, 2 },
+    });
+
+    ASSERT_TRUE( BoxFilter(1).apply(test) == expected );
+}
+
+
+TEST(box_filter, matches_naive)
+{
+    for (index_t radius : { 1, 2, 5, 16, 40 })
+        for (auto size : { std::make_pair(index_t(1), index_t(1)), std::make_pair(index_t(7), index_t(3)),
+                           std::make_pair(index_t(33), index_t(65)), std::make_pair(index_t(50), index_t(9)) })
+        {
+            auto source = fixture::pattern_matrix<float>(size.first, size.second);
+            auto result = BoxFilter(radius).apply(source);
+
+            ASSERT_LT((result.cast<double>() - naive_box(source, radius)).cwiseAbs().maxCoeff(), 1e-4)
+                << "radius " << radius << ", " << size.first << "x" << size.second;
+
+            auto source8 = fixture::pattern_matrix<uint8_t>(size.first, size.second);
+            auto result8 = BoxFilter(radius).apply(source8);
+
+            ASSERT_LE((result8.cast<double>() - naive_box(source8, radius)).cwiseAbs().maxCoeff(), 0.5 + 1e-9);
+
+            auto source16 = fixture::pattern_matrix<int16_t>(size.first, size.second);
+            auto result16 = BoxFilter(radius).apply(source16, 3);
+
+            ASSERT_LE((result16.cast<double>() - naive_box(source16, radius)).cwiseAbs().maxCoeff(), 0.5 + 1e-9);
+        }
+}
+
+
+TEST(box_filter, in_place_and_threads)
+{
+    auto source   = fixture::pattern_matrix<uint16_t>(97, 41);
+    auto expected = BoxFilter(6).apply(source);
+
+    for (index_t threads : { 1, 2, 4 })
+    {
+        auto copy = source;
+
+        BoxFilter(6).apply(ex::in_place, copy, threads);
+
+        ASSERT_TRUE(copy == expected) << threads;
+        ASSERT_TRUE(BoxFilter(6).apply(source, threads) == expected) << threads;
+    }
+}
+
+
+
+TEST(box_filter, large_radius_8bit)
+{
+    // (2r + 1)^2 * 255 > 2^31 - 1: int32_t sums would overflow
+    Matrix<uint8_t> source = Matrix<uint8_t>::Constant(2910, 2910, 255);
+    source(1455, 1455) = 0;
+
+    auto result = BoxFilter(1455).apply(source, 4);
+
+    ASSERT_EQ(result(1455, 1455), 255);
+    ASSERT_EQ(result(0, 0), 255);
+    ASSERT_EQ(result.minCoeff(), 255);
+}
+
+TEST(box_filter, expressions)
+{
+    auto source = fixture::pattern_matrix<float>(40, 30);
+
+    Matrix<float> transposed = BoxFilter(3).apply(source.transpose());
+    Matrix<float> expected   = BoxFilter(3).apply(source).transpose();
+
+    ASSERT_TRUE(transposed.isApprox(expected, 1e-6f));
+
+    auto copy = source;
+
+    BoxFilter(2).apply(ex::in_place, copy.block(5, 5, 20, 10));
+
+    Matrix<float> block = source.block(5, 5, 20, 10);
+
+    ASSERT_TRUE(copy.block(5, 5, 20, 10).isApprox(BoxFilter(2).apply(block), 1e-6f));
+    ASSERT_TRUE(copy.block(0, 0, 5, 30) == source.block(0, 0, 5, 30));
+
+    ASSERT_THROW(BoxFilter(0), std::logic_error);
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <imp/common/matrix>
+#include <imp/filter/convolution>
+#include <imp/image/rgb_image>
+
+#include "fixture"
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+Matrix<double> test_kernel(index_t rows, index_t cols)
+{
+    Matrix<double> kernel(rows, cols);
+
+    for (index_t i = 0; i < rows; ++i)
+        for (index_t j = 0; j < cols; ++j)
+            kernel(i, j) = double((i*7 + j*3) % 11) / 50 - 0.08;
+
+    return kernel;
+}
+
+
+// out(y, x) = sum k(i, j) * in(y - i, x - j) in double, edges replicated
+template <typename T>
+Matrix<double> naive_convolution(const Matrix<T>& matrix, const Matrix<double>& kernel)
+{
+    const index_t ry = kernel.rows() / 2;
+    const index_t rx = kernel.cols() / 2;
+
+    Matrix<double> result(matrix.rows(), matrix.cols());
+
+    for (index_t y = 0; y < matrix.rows(); ++y)
+        for (index_t x = 0; x < matrix.cols(); ++x)
+        {
+            double sum = 0;
+
+            for (index_t i = -ry; i <= ry; ++i)
+                for (index_t j = -rx; j <= rx; ++j)
+                {
+                    index_t v = std::min(std::max<index_t>(y - i, 0), matrix.rows() - 1);
+                    index_t u = std::min(std::max<index_t>(x - j, 0), matrix.cols() - 1);
+
+                    sum += kernel(i + ry, j + rx)*double(matrix(v, u));
+                }
+
+            result(y, x) = sum;
+        }
+
+    return result;
+}
+
+
+template <class Filter>
+double max_error(const Filter& filter, const Matrix<float>& source, const Matrix<double>& kernel, index_t threads = 1)
+{
+    return (filter.apply(source, threads).template cast<double>() - naive_convolution(source, kernel)).cwiseAbs().maxCoeff();
+}
+
+
+}
+
+
+TEST(convolution_filter, impulse)
+{
+    // the kernel itself, not flipped: convolution, not correlation
+    Matrix<float> impulse = Matrix<float>::Zero(7, 9);
+
+    impulse(3, 4) = 1;
+
+    Matrix<float, 3, 5> kernel;
+
+    kernel << 1,  2,  3,  4,  5,
+              6,  7,  8,  9, 10,
+             11, 12, 13, 14, 15;
+
+    Matrix<float> expected = Matrix<float>::Zero(7, 9);
+
+    expected.block(2, 2, 3, 5) = kernel;
+
+    ASSERT_TRUE(make_convolution(kernel).apply(impulse) == expected);
+    ASSERT_TRUE(make_convolution(Matrix<float>(kernel)).apply(impulse) == expected);
+
+    RowVector<float, 3> vertical(1, 2, 3);
+    RowVector<float, 5> horizontal;
+
+    horizontal << 1, 0, -1, 0, 2;
+
+    expected.block(2, 2, 3, 5) = vertical.transpose()*horizontal;
+
+    ASSERT_TRUE(make_convolution(vertical, horizontal).apply(impulse) == expected);
+    ASSERT_TRUE(make_convolution(RowVector<float>(vertical), Vector<float>(horizontal.transpose())).apply(impulse) == expected);
+
+    ASSERT_THROW(make_convolution(Matrix<float>(2, 3)), std::logic_error);
+    ASSERT_THROW(make_convolution(RowVector<float>(3), RowVector<float>(0)), std::logic_error);
+}
+
+
+TEST(convolution_filter, kernels)
+{
+    auto source = fixture::random_matrix<float>(37, 61);
+
+    // fixed sizes: unrolled
+    Matrix<double> k3 = test_kernel(3, 3), k5x7 = test_kernel(5, 7), k9 = test_kernel(9, 9);
+
+    ASSERT_LT(max_error(make_convolution(Matrix<float, 3, 3>(k3.cast<float>())), source, k3), 1e-3);
+    ASSERT_LT(max_error(make_convolution(Matrix<float, 5, 7>(k5x7.cast<float>())), source, k5x7), 1e-3);
+    ASSERT_LT(max_error(make_convolution(Matrix<float, 9, 9>(k9.cast<float>())), source, k9), 1e-3);  // too large to unroll
+
+    Matrix<double> column = test_kernel(5, 1);
+
+    ASSERT_LT(max_error(make_convolution(Vector<float, 5>(column.cast<float>())), source, column), 1e-3);
+
+    // runtime sizes: tiled
+    ASSERT_LT(max_error(make_convolution(k5x7.cast<float>()), source, k5x7), 1e-3);
+    ASSERT_LT(max_error(make_convolution(k9), source, k9, 3), 1e-3);
+
+    // separable, fixed and runtime
+    Matrix<double> v = test_kernel(1, 7), h = test_kernel(1, 5);
+
+    ASSERT_LT(max_error(make_convolution(RowVector<float, 7>(v.cast<float>()), RowVector<float, 5>(h.cast<float>())),
+                        source, v.transpose()*h), 1e-3);
+    ASSERT_LT(max_error(make_convolution(v, h), source, v.transpose()*h, 2), 1e-3);
+}
+
+
+TEST(convolution_filter, integral_types)
+{
+    Matrix<float, 3, 3> sharpen;
+
+    sharpen << 0, -1, 0, -1, 5, -1, 0, -1, 0;
+
+    auto source   = fixture::random_matrix<uint8_t>(19, 23);
+    auto expected = naive_convolution(source, sharpen.cast<double>());
+
+    Matrix<uint8_t> result = make_convolution(sharpen).apply(source);
+
+    for (index_t y = 0; y < 19; ++y)
+        for (index_t x = 0; x < 23; ++x)
+            ASSERT_EQ(int(result(y, x)), int(std::lround(std::min(std::max(expected(y, x), 0.0), 255.0)))) << y << ", " << x;
+}
+
+
+TEST(convolution_filter, tiles_in_place_and_threads)
+{
+    // 61 kernel rows: strips of 1024 columns
+    auto source = fixture::random_matrix<uint16_t>(40, 2500);
+
+    Matrix<double> tall = test_kernel(61, 3);
+    Matrix<double> v    = test_kernel(1, 61), h = test_kernel(1, 5);
+
+    auto filter    = make_convolution(tall);
+    auto separable = make_convolution(v, h);
+
+    Matrix<uint16_t> expected = naive_convolution(source, tall).cwiseMax(0).cwiseMin(65535).array().round().cast<uint16_t>();
+    Matrix<uint16_t> expected_separable = separable.apply(source);
+
+    Matrix<double> naive_separable = naive_convolution(source, Matrix<double>(v.transpose()*h)).cwiseMax(0).cwiseMin(65535);
+
+    ASSERT_LE((expected_separable.cast<double>() - naive_separable).cwiseAbs().maxCoeff(), 0.51);
+
+    for (index_t threads : { 1, 2, 4 })
+    {
+        ASSERT_LE((filter.apply(source, threads).cast<int>() - expected.cast<int>()).cwiseAbs().maxCoeff(), 1) << threads;
+
+        auto copy = source;
+
+        separable.apply(ex::in_place, copy, threads);
+
+        ASSERT_TRUE(copy == expected_separable) << threads;
+    }
+
+    // single tile in place, expressions
+    auto small = fixture::random_matrix<float>(31, 17);
+
+    Matrix<float, 5, 5> kernel = test_kernel(5, 5).cast<float>();
+
+    auto copy = small;
+
+    make_convolution(kernel).apply(ex::in_place, copy);
+
+    ASSERT_TRUE(copy == make_convolution(kernel).apply(small));
+
+    Matrix<float> transposed = make_convolution(kernel).apply(small.transpose());
+
+    ASSERT_TRUE(transposed == make_convolution(kernel).apply(Matrix<float>(small.transpose())));
+
+    copy = small;
+
+    make_convolution(kernel).apply(ex::in_place, copy.block(3, 2, 20, 10));
+
+    ASSERT_TRUE(copy.block(3, 2, 20, 10) == make_convolution(kernel).apply(Matrix<float>(small.block(3, 2, 20, 10))));
+
+    copy = small;
+
+    make_convolution(kernel).apply(ex::in_place, copy.transpose(), 2);
+
+    ASSERT_TRUE(copy.transpose() == transposed);
+}
+
+
+TEST(convolution_filter, image_planes)
+{
+    RgbImage<uint8_t> image(23, 31);
+
+    for (index_t c = 0; c < 3; ++c) image.plane(c) = fixture::random_matrix<uint8_t>(23, 31, uint32_t(c + 1));
+
+    RowVector<float, 3> taps(0.25f, 0.5f, 0.25f);
+
+    auto filter = make_convolution(taps, taps);
+    auto result = filter.apply(image, 2);
+
+    auto copy = image;
+
+    filter.apply(ex::in_place, copy);
+
+    for (index_t c = 0; c < 3; ++c)
+    {
+        ASSERT_TRUE(result.plane(c) == filter.apply(Matrix<uint8_t>(image.plane(c)))) << c;
+        ASSERT_TRUE(copy.plane(c) == result.plane(c)) << c;
+    }
+}
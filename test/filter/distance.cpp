@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include <imp/common/matrix>
+#include <imp/filter/distance>
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+// sparse features: about one pixel of `density`
+Matrix<uint8_t> test_mask(index_t rows, index_t cols, uint32_t density, uint32_t seed = 1)
+{
+    Matrix<uint8_t> mask(rows, cols);
+
+    uint32_t state = seed;
+
+    for (index_t y = 0; y < rows; ++y)
+        for (index_t x = 0; x < cols; ++x)
+        {
+            state = state*1664525u + 1013904223u;
+            mask(y, x) = uint8_t((state >> 8) % density == 0 ? 255 : 0);
+        }
+
+    return mask;
+}
+
+
+// squared distance to the nearest feature by brute force, -1 without features
+Matrix<int64_t> naive_squared(const Matrix<uint8_t>& mask)
+{
+    Matrix<int64_t> result = Matrix<int64_t>::Constant(mask.rows(), mask.cols(), -1);
+
+    for (index_t v = 0; v < mask.rows(); ++v)
+        for (index_t u = 0; u < mask.cols(); ++u)
+        {
+            if (mask(v, u) == 0) continue;
+
+            for (index_t y = 0; y < mask.rows(); ++y)
+                for (index_t x = 0; x < mask.cols(); ++x)
+                {
+                    int64_t d = (y - v)*(y - v) + (x - u)*(x - u);
+
+                    if (result(y, x) < 0 || d < result(y, x)) result(y, x) = d;
+                }
+        }
+
+    return result;
+}
+
+
+}
+
+
+TEST(distance_transform, exact)
+{
+    for (uint32_t density : { 3u, 40u, 400u })
+    {
+        auto mask     = test_mask(37, 53, density, density);
+        auto expected = naive_squared(mask);
+
+        auto squared   = DistanceTransform(kDistanceSquared).apply<uint32_t>(mask);
+        auto euclidean = DistanceTransform().apply(mask);
+
+        ASSERT_TRUE(squared.cast<int64_t>() == expected) << density;
+        ASSERT_LT((euclidean.cast<double>() - expected.cast<double>().cwiseSqrt()).cwiseAbs().maxCoeff(), 1e-4) << density;
+    }
+
+    // a single feature: the distance grows further than any window based approach would reach
+    Matrix<uint8_t> mask = Matrix<uint8_t>::Zero(300, 7);
+
+    mask(299, 0) = 1;
+
+    auto distance = DistanceTransform().apply<double>(mask);
+
+    ASSERT_DOUBLE_EQ(distance(0, 6), std::sqrt(299.0*299.0 + 36.0));
+    ASSERT_DOUBLE_EQ(distance(299, 0), 0.0);
+}
+
+
+TEST(distance_transform, no_features)
+{
+    Matrix<uint8_t> mask = Matrix<uint8_t>::Zero(5, 8);
+
+    ASSERT_TRUE((DistanceTransform().apply(mask).array() == std::numeric_limits<float>::infinity()).all());
+    ASSERT_TRUE((DistanceTransform(kDistanceSquared).apply<uint16_t>(mask).array() == 65535).all());
+    ASSERT_TRUE((DistanceTransform(kDistanceChamfer).apply(mask).array() == std::numeric_limits<float>::infinity()).all());
+
+    // features in some rows only, rows without features see them through the columns
+    mask(2, 3) = 1;
+
+    ASSERT_FLOAT_EQ(DistanceTransform().apply(mask)(4, 7), std::sqrt(4.0f + 16.0f));
+
+    ASSERT_EQ(DistanceTransform().apply(Matrix<uint8_t>(0, 3)).size(), 0);
+}
+
+
+TEST(distance_transform, chamfer)
+{
+    auto mask     = test_mask(61, 83, 500, 5);
+    Matrix<double> expected = naive_squared(mask).cast<double>().cwiseSqrt();
+
+    auto chamfer = DistanceTransform(kDistanceChamfer).apply(mask);
+
+    for (index_t y = 0; y < mask.rows(); ++y)
+        for (index_t x = 0; x < mask.cols(); ++x)
+            ASSERT_NEAR(double(chamfer(y, x)), expected(y, x), 0.03*expected(y, x) + 0.2) << y << ", " << x;
+
+    // multiples of 1/5 of a pixel, 0 on the features
+    ASSERT_TRUE(((chamfer*5).array().round() - chamfer.array()*5).abs().maxCoeff() < 1e-3f);
+    ASSERT_TRUE(((mask.array() != 0) == (chamfer.array() == 0)).all());
+}
+
+
+TEST(distance_transform, threads_and_expressions)
+{
+    auto mask     = test_mask(131, 257, 900, 7);
+    auto expected = DistanceTransform(kDistanceSquared).apply<int32_t>(mask);
+
+    for (index_t threads : { 2, 3, 8 })
+        ASSERT_TRUE(DistanceTransform(kDistanceSquared).apply<int32_t>(mask, threads) == expected) << threads;
+
+    Matrix<int32_t> transposed = DistanceTransform(kDistanceSquared).apply<int32_t>(mask.transpose(), 2);
+
+    ASSERT_TRUE(transposed == Matrix<int32_t>(expected.transpose()));
+
+    Matrix<bool> features = mask.array() != 0;
+
+    ASSERT_TRUE(DistanceTransform(kDistanceSquared).apply<int32_t>(features) == expected);
+}
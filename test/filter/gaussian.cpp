@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <imp/common/matrix>
+#include <imp/filter/gaussian>
+#include <imp/image/rgb_image>
+
+#include "fixture"
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+// 2D convolution with the sampled kernel of radius ceil(3*sigma), edges replicated
+template <typename T>
+Matrix<double> naive_gaussian(const Matrix<T>& matrix, double sigma)
+{
+    const index_t radius = std::max<index_t>(1, index_t(std::ceil(3*sigma)));
+
+    double total = 0;
+
+    for (index_t k = -radius; k <= radius; ++k) total += std::exp(-0.5*double(k*k) / (sigma*sigma));
+
+    Matrix<double> result(matrix.rows(), matrix.cols());
+
+    for (index_t y = 0; y < matrix.rows(); ++y)
+        for (index_t x = 0; x < matrix.cols(); ++x)
+        {
+            double sum = 0;
+
+            for (index_t i = -radius; i <= radius; ++i)
+                for (index_t j = -radius; j <= radius; ++j)
+                {
+                    index_t v = std::min(std::max<index_t>(y + i, 0), matrix.rows() - 1);
+                    index_t u = std::min(std::max<index_t>(x + j, 0), matrix.cols() - 1);
+
+                    sum += double(matrix(v, u)) * std::exp(-0.5*double(i*i + j*j) / (sigma*sigma));
+                }
+
+            result(y, x) = sum / (total*total);
+        }
+
+    return result;
+}
+
+
+}
+
+
+TEST(gaussian_filter, constant)
+{
+    for (double sigma : { 0.5, 4.0, 25.0, 50.0 })
+    {
+        Matrix<float> test = Matrix<float>::Constant(30, 20, 100.0f);
+
+        ASSERT_LT((GaussianFilter(sigma).apply(test).array() - 100.0f).abs().maxCoeff(), 1e-3f) << sigma;
+
+        Matrix<uint8_t> test8 = Matrix<uint8_t>::Constant(30, 20, 200);
+
+        ASSERT_TRUE(GaussianFilter(sigma).apply(test8) == test8) << sigma;
+    }
+}
+
+
+TEST(gaussian_filter, fir_matches_naive)
+{
+    for (double sigma : { 0.5, 1.0, 2.5, 6.0 })
+        for (auto size : { std::make_pair(index_t(1), index_t(1)), std::make_pair(index_t(7), index_t(3)),
+                           std::make_pair(index_t(33), index_t(45)) })
+        {
+            ASSERT_FALSE(GaussianFilter(sigma).recursive());
+
+            auto source = fixture::pattern_matrix<float>(size.first, size.second);
+            auto result = GaussianFilter(sigma).apply(source);
+
+            ASSERT_LT((result.cast<double>() - naive_gaussian(source, sigma)).cwiseAbs().maxCoeff(), 1e-3)
+                << "sigma " << sigma << ", " << size.first << "x" << size.second;
+
+            auto source8 = fixture::pattern_matrix<uint8_t>(size.first, size.second);
+            auto result8 = GaussianFilter(sigma).apply(source8, 3);
+
+            ASSERT_LE((result8.cast<double>() - naive_gaussian(source8, sigma)).cwiseAbs().maxCoeff(), 0.5 + 1e-3);
+        }
+}
+
+
+TEST(gaussian_filter, iir_matches_naive)
+{
+    const double sigma = 12;
+
+    ASSERT_TRUE(GaussianFilter(sigma).recursive());
+
+    // impulse response, peak 1 / (2*pi*sigma^2)
+    Matrix<float> impulse = Matrix<float>::Zero(101, 101);
+
+    impulse(50, 50) = 1;
+
+    Matrix<double> expected = naive_gaussian(impulse, sigma);
+    Matrix<double> result   = GaussianFilter(sigma).apply(impulse).cast<double>();
+
+    // the naive kernel is cut at 3 sigma and renormalized: its peak is ~0.5% higher
+    ASSERT_LT((result - expected).cwiseAbs().maxCoeff(), 0.01*expected.maxCoeff());
+    ASSERT_NEAR(result.sum(), 1.0, 1e-3);
+
+    auto source = fixture::pattern_matrix<float>(48, 64);
+
+    ASSERT_LT((GaussianFilter(sigma).apply(source).cast<double>() - naive_gaussian(source, sigma)).cwiseAbs().maxCoeff(), 1.0);
+}
+
+
+TEST(gaussian_filter, in_place_and_threads)
+{
+    for (double sigma : { 1.5, 12.0 })
+    {
+        auto source   = fixture::pattern_matrix<uint16_t>(97, 41);
+        auto expected = GaussianFilter(sigma).apply(source);
+
+        for (index_t threads : { 1, 2, 4 })
+        {
+            auto copy = source;
+
+            GaussianFilter(sigma).apply(ex::in_place, copy, threads);
+
+            ASSERT_TRUE(copy == expected) << sigma << ", " << threads;
+            ASSERT_TRUE(GaussianFilter(sigma).apply(source, threads) == expected) << sigma << ", " << threads;
+        }
+    }
+
+    ASSERT_THROW(GaussianFilter(0), std::logic_error);
+}
+
+
+TEST(gaussian_filter, image_planes)
+{
+    RgbImage<uint8_t> image(23, 31);
+
+    for (index_t c = 0; c < 3; ++c) image.plane(c) = fixture::pattern_matrix<uint8_t>(23, 31).array() / uint8_t(c + 1);
+
+    for (double sigma : { 1.0, 12.0 })
+    {
+        auto result = GaussianFilter(sigma).apply(image, 2);
+
+        auto copy = image;
+
+        GaussianFilter(sigma).apply(ex::in_place, copy);
+
+        for (index_t c = 0; c < 3; ++c)
+        {
+            Matrix<uint8_t> plane = image.plane(c);
+
+            ASSERT_TRUE(result.plane(c) == GaussianFilter(sigma).apply(plane)) << c;
+            ASSERT_TRUE(copy.plane(c) == result.plane(c)) << c;
+        }
+    }
+}
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+
+#include <imp/common/matrix>
+#include <imp/filter/guided>
+#include <imp/image/rgb_image>
+
+#include "fixture"
+
+#include <Eigen/LU> // 3x3 inverse
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+// box mean in double, window clipped by the borders
+Matrix<double> naive_mean(const Matrix<double>& matrix, index_t radius)
+{
+    Matrix<double> result(matrix.rows(), matrix.cols());
+
+    for (index_t y = 0; y < matrix.rows(); ++y)
+        for (index_t x = 0; x < matrix.cols(); ++x)
+        {
+            index_t top  = std::max<index_t>(y - radius, 0), bottom = std::min(y + radius, matrix.rows() - 1);
+            index_t left = std::max<index_t>(x - radius, 0), right  = std::min(x + radius, matrix.cols() - 1);
+
+            result(y, x) = matrix.block(top, left, bottom - top + 1, right - left + 1).mean();
+        }
+
+    return result;
+}
+
+
+// the guided filter formulas over naive means, RGB guide
+Matrix<double> naive_guided(const Matrix<double>& p, const std::array<Matrix<double>, 3>& I, index_t r, double eps)
+{
+    const index_t rows = p.rows(), cols = p.cols();
+
+    std::array<Matrix<double>, 3> mean_I, mean_Ip, a, mean_a;
+    Matrix<double> mean_II[3][3];
+
+    for (int i = 0; i < 3; ++i)
+    {
+        mean_I[i]  = naive_mean(I[i], r);
+        mean_Ip[i] = naive_mean(I[i].cwiseProduct(p), r);
+
+        for (int j = 0; j < 3; ++j) mean_II[i][j] = naive_mean(I[i].cwiseProduct(I[j]), r);
+
+        a[i].resize(rows, cols);
+    }
+
+    Matrix<double> mean_p = naive_mean(p, r), b(rows, cols);
+
+    for (index_t y = 0; y < rows; ++y)
+        for (index_t x = 0; x < cols; ++x)
+        {
+            Eigen::Matrix3d sigma;
+            Eigen::Vector3d cov;
+
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                    sigma(i, j) = mean_II[i][j](y, x) - mean_I[i](y, x)*mean_I[j](y, x) + (i == j ? eps : 0);
+
+                cov(i) = mean_Ip[i](y, x) - mean_I[i](y, x)*mean_p(y, x);
+            }
+
+            Eigen::Vector3d coef = sigma.inverse()*cov;
+
+            b(y, x) = mean_p(y, x);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                a[i](y, x) = coef(i);
+                b(y, x) -= coef(i)*mean_I[i](y, x);
+            }
+        }
+
+    Matrix<double> q = naive_mean(b, r);
+
+    for (int i = 0; i < 3; ++i) q += naive_mean(a[i], r).cwiseProduct(I[i]);
+
+    return q;
+}
+
+
+}
+
+
+TEST(guided_filter, gray_guide)
+{
+    auto source = fixture::edge_matrix<float>(37, 53);
+
+    Matrix<double> p = source.cast<double>();
+
+    for (index_t radius : { 1, 4 })
+        for (double eps : { 10.0, 1000.0 })
+        {
+            // gray guide: the RGB formulas with equal planes and eps/3 on each of them
+            Matrix<double> expected = naive_guided(p, {{ p/3, p/3, p/3 }}, radius, eps/3);
+
+            auto result = GuidedFilter(radius, eps).apply(source, source, 2);
+
+            ASSERT_LT((result.cast<double>() - expected).cwiseAbs().maxCoeff(), 0.05) << radius << ", " << eps;
+        }
+
+    // the step survives, the texture of the sides is smoothed out
+    auto result = GuidedFilter(4, 400).apply(source, source);
+
+    ASSERT_GT(result.col(27).minCoeff() - result.col(25).maxCoeff(), 120.0f);
+    ASSERT_LT(result.block(5, 5, 27, 15).maxCoeff() - result.block(5, 5, 27, 15).minCoeff(), 10.0f);
+
+    ASSERT_THROW(GuidedFilter(0, 1), std::logic_error);
+    ASSERT_THROW(GuidedFilter(1, 0), std::logic_error);
+    ASSERT_THROW(GuidedFilter(1, 1, 0), std::logic_error);
+    ASSERT_THROW(GuidedFilter(1, 1).apply(source, Matrix<float>(37, 52)), std::logic_error);
+}
+
+
+TEST(guided_filter, rgb_guide)
+{
+    RgbImage<uint8_t> guide(31, 45);
+
+    for (index_t c = 0; c < 3; ++c) guide.plane(c) = fixture::edge_matrix<uint8_t>(31, 45, int(5*c));
+
+    std::array<Matrix<double>, 3> I;
+
+    for (index_t c = 0; c < 3; ++c) I[size_t(c)] = Matrix<uint8_t>(guide.plane(c)).cast<double>();
+
+    Matrix<float> mask = Matrix<float>::Zero(31, 45);
+
+    mask.block(0, 0, 31, 20).setConstant(1.0f);
+
+    for (index_t radius : { 2, 5 })
+    {
+        Matrix<double> expected = naive_guided(mask.cast<double>(), I, radius, 50);
+
+        auto result = GuidedFilter(radius, 50).apply(mask, guide, 3);
+
+        ASSERT_LT((result.cast<double>() - expected).cwiseAbs().maxCoeff(), 1e-3) << radius;
+    }
+
+    // every plane of an RGB image, self-guided, in place
+    auto copy = guide;
+
+    GuidedFilter filter(3, 200);
+
+    filter.apply(ex::in_place, copy, copy, 2);
+
+    for (index_t c = 0; c < 3; ++c)
+    {
+        Matrix<double> expected = naive_guided(I[size_t(c)], I, 3, 200);
+
+        ASSERT_LT((Matrix<uint8_t>(copy.plane(c)).cast<double>() - expected).cwiseAbs().maxCoeff(), 0.51) << c;
+    }
+
+    ASSERT_TRUE(filter.apply(guide, guide) == copy);
+}
+
+
+TEST(guided_filter, subsampling)
+{
+    auto source = fixture::edge_matrix<float>(120, 161);
+
+    for (index_t s : { 2, 4 })
+    {
+        auto exact = GuidedFilter(8, 200).apply(source, source);
+        auto fast  = GuidedFilter(8, 200, s).apply(source, source);
+
+        ASSERT_LT((fast - exact).cwiseAbs().mean(), 1.5f) << s;
+        ASSERT_GT(fast.col(81).minCoeff() - fast.col(79).maxCoeff(), 100.0f) << s;
+    }
+
+    // sizes not divisible by s, smaller than s
+    for (auto size : { std::make_pair(index_t(1), index_t(1)), std::make_pair(index_t(3), index_t(7)),
+                       std::make_pair(index_t(17), index_t(10)) })
+    {
+        Matrix<uint16_t> flat = Matrix<uint16_t>::Constant(size.first, size.second, 1000);
+
+        ASSERT_TRUE(GuidedFilter(3, 10, 4).apply(flat, flat) == flat) << size.first << "x" << size.second;
+    }
+}
+
+
+TEST(guided_filter, in_place_threads_and_workspace)
+{
+    auto source = fixture::edge_matrix<uint8_t>(67, 45);
+    auto guide  = fixture::edge_matrix<uint8_t>(67, 45, 3);
+
+    GuidedFilter filter(5, 100, 2);
+
+    auto expected = filter.apply(source, guide);
+
+    const size_t bytes = filter.workspace_bytes();
+
+    ASSERT_GT(bytes, 0u);
+
+    for (index_t threads : { 1, 2, 4 })
+    {
+        auto copy = source;
+
+        filter.apply(ex::in_place, copy, guide, threads);
+
+        ASSERT_TRUE(copy == expected) << threads;
+        ASSERT_TRUE(filter.apply(source, guide, threads) == expected) << threads;
+
+        // self-guided in place: the guide is read before it's overwritten
+        copy = source;
+
+        filter.apply(ex::in_place, copy, copy, threads);
+
+        ASSERT_TRUE(copy == filter.apply(source, source)) << threads;
+    }
+
+    // the workspace is reused, smaller images don't grow it
+    filter.apply(Matrix<uint8_t>(source.block(0, 0, 30, 40)), guide.block(0, 0, 30, 40));
+
+    ASSERT_EQ(filter.workspace_bytes(), bytes);
+
+    Matrix<uint8_t> transposed = filter.apply(source.transpose(), guide.transpose());
+    Matrix<uint8_t> expected_t = filter.apply(Matrix<uint8_t>(source.transpose()), Matrix<uint8_t>(guide.transpose()));
+
+    ASSERT_TRUE(transposed == expected_t);
+
+    auto copy = source;
+
+    filter.apply(ex::in_place, copy.block(5, 7, 40, 30), guide.block(5, 7, 40, 30));
+
+    ASSERT_TRUE(copy.block(5, 7, 40, 30) == filter.apply(Matrix<uint8_t>(source.block(5, 7, 40, 30)), guide.block(5, 7, 40, 30)));
+}
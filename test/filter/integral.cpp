@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include <imp/common/matrix>
+#include <imp/filter/box>
+#include <imp/filter/integral>
+
+#include "fixture"
+
+
+using namespace imp;
+
+
+TEST(integral_test, table)
+{
+    Matrix<uint8_t> test({
+        { 1, 2, 3 },
+        { 4, 5, 6 },
+    });
+
+    Matrix<uint32_t> expected({
+        { 0, 0,  0,  0 },
+        { 0, 1,  3,  6 },
+        { 0, 5, 12, 21 },
+    });
+
+    auto integral = make_integral(test);
+
+    static_assert(std::is_same<decltype(integral)::value_type, uint32_t>::value, "8-bit sums are uint32_t");
+
+    ASSERT_TRUE(integral.table() == expected);
+    ASSERT_EQ(integral.rows(), 2);
+    ASSERT_EQ(integral.cols(), 3);
+
+    ASSERT_EQ(integral.sum(0, 0, 2, 3), 21u);
+    ASSERT_EQ(integral.sum(1, 1, 1, 2), 11u);
+    ASSERT_EQ(integral.sum(0, 2, 2, 1), 9u);
+    ASSERT_EQ(integral.sum(1, 1, 0, 0), 0u);
+}
+
+
+TEST(integral_test, rectangles_and_threads)
+{
+    auto source = fixture::pattern_matrix<int16_t>(301, 77);
+
+    auto single = make_integral(source);
+
+    for (index_t threads : { 2, 3, 8 })
+        ASSERT_TRUE(make_integral(source, threads).table() == single.table()) << threads;
+
+    for (index_t top = 0; top < source.rows(); top += 13)
+        for (index_t left = 0; left < source.cols(); left += 7)
+        {
+            index_t height = std::min<index_t>(41, source.rows() - top);
+            index_t width  = std::min<index_t>(19, source.cols() - left);
+
+            ASSERT_EQ(single.sum(top, left, height, width), source.block(top, left, height, width).cast<int64_t>().sum());
+        }
+
+    auto transposed = make_integral(source.transpose(), 2);
+
+    ASSERT_TRUE(transposed.table() == single.table().transpose());
+}
+
+
+TEST(integral_test, wrap_around)
+{
+    // the whole table overflows uint32_t, rectangle sums of up to 16 MPix stay exact
+    Matrix<uint8_t> source = Matrix<uint8_t>::Constant(4500, 4000, 255);
+
+    auto integral = make_integral(source, 4);
+
+    ASSERT_EQ(integral.sum(100, 100, 4000, 3000), 255u*4000u*3000u);
+    ASSERT_EQ(integral.sum(4499, 3999, 1, 1), 255u);
+}
+
+
+TEST(integral_test, local_statistics)
+{
+    auto source = fixture::pattern_matrix<uint8_t>(64, 48);
+
+    auto integral = make_integral(source, 2);
+    auto squares  = make_squared_integral(source, 2);
+
+    Matrix<double> block = source.block(10, 5, 20, 30).cast<double>();
+
+    double mean     = block.mean();
+    double variance = (block.array() - mean).square().mean();
+
+    ASSERT_NEAR(integral.mean(10, 5, 20, 30), mean, 1e-9);
+    ASSERT_NEAR(local_variance(integral, squares, 10, 5, 20, 30), variance, 1e-6);
+
+    // squares of 32-bit samples overflow 64-bit integers after a few pixels: summed in double
+    static_assert(std::is_same<decltype(make_squared_integral(Matrix<int32_t>()).sum(0, 0, 1, 1)), double>::value, "");
+    static_assert(std::is_same<decltype(make_squared_integral(Matrix<int16_t>()).sum(0, 0, 1, 1)), int64_t>::value, "");
+
+    Matrix<int32_t> extremes(16, 16);
+
+    for (index_t i = 0; i < extremes.size(); ++i)
+        extremes(i) = (i % 2 == 0) ? std::numeric_limits<int32_t>::max() : std::numeric_limits<int32_t>::lowest();
+
+    auto extreme_squares = make_squared_integral(extremes, 2);
+
+    ASSERT_NEAR(extreme_squares.sum(0, 0, 16, 16) / std::ldexp(256.0, 62), 1.0, 1e-9);
+    // samples at -1/2 +- (2^31 - 1/2)
+    double extreme_variance = std::ldexp(1.0, 31) - 0.5;
+
+    ASSERT_NEAR(local_variance(make_integral(extremes), extreme_squares, 0, 0, 16, 16) / (extreme_variance*extreme_variance), 1.0, 1e-12);
+}
+
+
+TEST(integral_test, box_filter)
+{
+    auto source = fixture::pattern_matrix<uint8_t>(90, 70);
+
+    auto integral = make_integral(source, 3);
+
+    for (index_t radius : { 1, 4, 50 })
+    {
+        Matrix<uint8_t> direct = BoxFilter(radius).apply(source);
+
+        ASSERT_TRUE(BoxFilter(radius).from_integral<uint8_t>(integral, 2) == direct) << radius;
+    }
+
+    auto sourcef = fixture::pattern_matrix<float>(90, 70);
+
+    Matrix<float> direct = BoxFilter(3).apply(sourcef);
+
+    ASSERT_TRUE(BoxFilter(3).from_integral<float>(make_integral(sourcef)).isApprox(direct, 1e-6f));
+}
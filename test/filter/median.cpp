@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <imp/common/matrix>
+#include <imp/filter/median>
+#include <imp/image/rgb_image>
+
+#include "fixture"
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+// median of the full window, edges replicated
+template <typename T>
+Matrix<T> naive_median(const Matrix<T>& matrix, index_t radius)
+{
+    Matrix<T> result(matrix.rows(), matrix.cols());
+
+    std::vector<T> window;
+
+    for (index_t y = 0; y < matrix.rows(); ++y)
+        for (index_t x = 0; x < matrix.cols(); ++x)
+        {
+            window.clear();
+
+            for (index_t i = -radius; i <= radius; ++i)
+                for (index_t j = -radius; j <= radius; ++j)
+                {
+                    index_t v = std::min(std::max<index_t>(y + i, 0), matrix.rows() - 1);
+                    index_t u = std::min(std::max<index_t>(x + j, 0), matrix.cols() - 1);
+
+                    window.push_back(matrix(v, u));
+                }
+
+            std::nth_element(window.begin(), window.begin() + window.size()/2, window.end());
+
+            result(y, x) = window[window.size()/2];
+        }
+
+    return result;
+}
+
+
+}
+
+
+TEST(median_filter, salt_and_pepper)
+{
+    Matrix<uint8_t> test({
+        { 10,  10,  10, 10 },
+        { 10, 255,  10, 10 },
+        { 10,  10,   0, 10 },
+        { 10,  10,  10, 10 },
+    });
+
+    ASSERT_TRUE( MedianFilter(1).apply(test) == Matrix<uint8_t>::Constant(4, 4, 10) );
+}
+
+
+TEST(median_filter, network)
+{
+    for (index_t radius : { 1, 2 })
+        for (auto size : { std::make_pair(index_t(1), index_t(1)), std::make_pair(index_t(7), index_t(3)),
+                           std::make_pair(index_t(33), index_t(150)) })
+        {
+            auto source8 = fixture::random_matrix<uint8_t>(size.first, size.second);
+
+            ASSERT_TRUE(MedianFilter(radius).apply(source8) == naive_median(source8, radius))
+                << "radius " << radius << ", " << size.first << "x" << size.second;
+
+            auto source16 = fixture::random_matrix<uint16_t>(size.first, size.second, 1, 16);
+
+            ASSERT_TRUE(MedianFilter(radius).apply(source16, 3) == naive_median(source16, radius))
+                << "radius " << radius << ", " << size.first << "x" << size.second;
+        }
+}
+
+
+TEST(median_filter, histogram)
+{
+    for (index_t radius : { 3, 7, 20 })
+        for (auto size : { std::make_pair(index_t(1), index_t(1)), std::make_pair(index_t(9), index_t(4)),
+                           std::make_pair(index_t(41), index_t(530)) })
+        {
+            auto source8 = fixture::random_matrix<uint8_t>(size.first, size.second);
+
+            ASSERT_TRUE(MedianFilter(radius).apply(source8) == naive_median(source8, radius))
+                << "radius " << radius << ", " << size.first << "x" << size.second;
+
+            auto source16 = fixture::random_matrix<uint16_t>(size.first, size.second, 7, 16);
+
+            ASSERT_TRUE(MedianFilter(radius).apply(source16, 2) == naive_median(source16, radius))
+                << "radius " << radius << ", " << size.first << "x" << size.second;
+        }
+}
+
+
+TEST(median_filter, in_place_and_threads)
+{
+    for (index_t radius : { 2, 5 })
+    {
+        auto source   = fixture::random_matrix<uint8_t>(97, 141);
+        auto expected = MedianFilter(radius).apply(source);
+
+        for (index_t threads : { 1, 2, 4 })
+        {
+            auto copy = source;
+
+            MedianFilter(radius).apply(ex::in_place, copy, threads);
+
+            ASSERT_TRUE(copy == expected) << radius << ", " << threads;
+            ASSERT_TRUE(MedianFilter(radius).apply(source, threads) == expected) << radius << ", " << threads;
+        }
+
+        Matrix<uint8_t> transposed = MedianFilter(radius).apply(source.transpose());
+        Matrix<uint8_t> block      = source.block(5, 7, 40, 30);
+
+        ASSERT_TRUE(transposed == naive_median(Matrix<uint8_t>(source.transpose()), radius));
+
+        auto copy = source;
+
+        MedianFilter(radius).apply(ex::in_place, copy.block(5, 7, 40, 30));
+
+        ASSERT_TRUE(copy.block(5, 7, 40, 30) == naive_median(block, radius));
+    }
+
+    ASSERT_THROW(MedianFilter(0), std::logic_error);
+}
+
+
+
+TEST(median_filter, large_radius_16bit)
+{
+    auto source8  = fixture::random_matrix<uint8_t>(3, 20, 1);
+    auto source16 = fixture::random_matrix<uint16_t>(3, 20, 1, 16);
+
+    for (index_t radius : { 233, 300 })
+    {
+        ASSERT_TRUE(MedianFilter(radius).apply(source8) == naive_median(source8, radius)) << radius;
+        ASSERT_TRUE(MedianFilter(radius).apply(source16, 2) == naive_median(source16, radius)) << radius;
+    }
+
+    // rows with a pixel stride are copied, blocks are read in place
+    auto large = fixture::random_matrix<uint16_t>(60, 45, 3, 16);
+
+    Matrix<uint16_t> transposed = large.transpose();
+    Matrix<uint16_t> block      = large.block(4, 6, 30, 25);
+
+    ASSERT_TRUE(MedianFilter(40).apply(large.transpose()) == naive_median(transposed, 40));
+    ASSERT_TRUE(MedianFilter(40).apply(large.block(4, 6, 30, 25)) == naive_median(block, 40));
+
+    // fewer fine slots than prefixes: 1 slot (no memory), 8 slots (256 KB)
+    for (index_t memory : { 0, 256*1024 })
+    {
+        Matrix<uint16_t> result(large.rows(), large.cols());
+
+        internal::median_filter(large, result, 7, 2, memory);
+
+        ASSERT_TRUE(result == naive_median(large, 7)) << memory;
+    }
+
+    ASSERT_THROW(MedianFilter(32768), std::logic_error);
+}
+
+
+TEST(median_filter, image_planes)
+{
+    RgbImage<uint16_t> image(23, 31);
+
+    for (index_t c = 0; c < 3; ++c) image.plane(c) = fixture::random_matrix<uint16_t>(23, 31, uint32_t(c + 1), 16);
+
+    for (index_t radius : { 1, 4 })
+    {
+        auto result = MedianFilter(radius).apply(image, 2);
+
+        auto copy = image;
+
+        MedianFilter(radius).apply(ex::in_place, copy);
+
+        for (index_t c = 0; c < 3; ++c)
+        {
+            Matrix<uint16_t> plane = image.plane(c);
+
+            ASSERT_TRUE(result.plane(c) == naive_median(plane, radius)) << c;
+            ASSERT_TRUE(copy.plane(c) == result.plane(c)) << c;
+        }
+    }
+}
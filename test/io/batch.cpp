@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+#include <imp/io/batch>
+#include <imp/io/pgm>
+
+
+using namespace imp;
+
+
+static std::vector<std::string> test_paths(index_t count)
+{
+    std::vector<std::string> paths;
+
+    for (index_t i = 0; i < count; ++i)
+    {
+        paths.push_back(std::to_string(i));
+    }
+
+    return paths;
+}
+
+
+TEST(batch_test, in_order)
+{
+    BatchLoader<Matrix<int>> batch(test_paths(20), [](const std::string& path)
+    {
+        int i = std::stoi(path);
+
+        // later images complete first
+        std::this_thread::sleep_for(std::chrono::microseconds(20 - i));
+
+        return Matrix<int>::Constant(2, 3, i).eval();
+    }, 4, 3);
+
+    ASSERT_EQ(batch.size(), 20);
+
+    Matrix<int> image;
+    index_t index;
+    int expected = 0;
+
+    while (batch.next(image, index))
+    {
+        ASSERT_EQ(index, expected);
+        ASSERT_TRUE(image == Matrix<int>::Constant(2, 3, expected));
+        ++expected;
+    }
+
+    ASSERT_EQ(expected, 20);
+    ASSERT_FALSE(batch.next(image));
+}
+
+
+TEST(batch_test, as_completed)
+{
+    BatchLoader<int> batch(test_paths(50), [](const std::string& path) { return std::stoi(path); },
+                           3, 5, BatchOrder::kAsCompleted);
+
+    std::vector<bool> seen(50, false);
+
+    int value;
+    index_t index;
+
+    while (batch.next(value, index))
+    {
+        ASSERT_EQ(value, index);
+        ASSERT_FALSE(seen[size_t(index)]);
+        seen[size_t(index)] = true;
+    }
+
+    for (bool s : seen)
+    {
+        ASSERT_TRUE(s);
+    }
+}
+
+
+TEST(batch_test, backpressure)
+{
+    std::atomic<int> loaded(0);
+    const index_t prefetch = 2;
+
+    BatchLoader<int> batch(test_paths(10), [&loaded](const std::string& path)
+    {
+        ++loaded;
+        return std::stoi(path);
+    }, 4, prefetch);
+
+    int value;
+    int consumed = 0;
+
+    // slow consumer: workers never run ahead more than `prefetch` images
+    while (batch.next(value))
+    {
+        ++consumed;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        ASSERT_LE(loaded.load(), consumed + prefetch);
+    }
+
+    ASSERT_EQ(consumed, 10);
+}
+
+
+TEST(batch_test, error_propagation)
+{
+    BatchLoader<int> batch(test_paths(4), [](const std::string& path)
+    {
+        if (path == "1")
+            throw std::runtime_error("bad file");
+
+        return std::stoi(path);
+    }, 2, 2);
+
+    int value;
+
+    ASSERT_TRUE(batch.next(value));
+    ASSERT_EQ(value, 0);
+
+    ASSERT_THROW(batch.next(value), std::runtime_error);
+
+    ASSERT_TRUE(batch.next(value));
+    ASSERT_EQ(value, 2);
+
+    ASSERT_TRUE(batch.next(value));
+    ASSERT_EQ(value, 3);
+
+    ASSERT_FALSE(batch.next(value));
+}
+
+
+TEST(batch_test, early_destruction)
+{
+    BatchLoader<int> batch(test_paths(100), [](const std::string& path) { return std::stoi(path); }, 4, 4);
+
+    int value;
+    ASSERT_TRUE(batch.next(value));
+
+    ASSERT_THROW(BatchLoader<int>(test_paths(1), [](const std::string&) { return 0; }, 1, 0), std::logic_error);
+}
+
+
+TEST(batch_test, load_pgm_files)
+{
+    std::vector<std::string> paths;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        std::string name = "batch_test_" + std::to_string(i) + ".pgm";
+        pgm::save(name.c_str(), Matrix<uint16_t>::Constant(3, 4, uint16_t(i)).eval(), uint16_t(4));
+        paths.push_back(name);
+    }
+
+    {
+        BatchLoader<Matrix<uint16_t>> batch(paths, [](const std::string& path) { return pgm::load<uint16_t>(path.c_str(), uint16_t(4)); }, 2, 2);
+
+        Matrix<uint16_t> image;
+        index_t index;
+
+        while (batch.next(image, index))
+        {
+            ASSERT_TRUE(image == Matrix<uint16_t>::Constant(3, 4, uint16_t(index)));
+        }
+    }
+
+    for (const auto& path : paths)
+    {
+        std::remove(path.c_str());
+    }
+}
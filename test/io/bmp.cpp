@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include <ex/stream/memory>
+#include <imp/io/bmp>
+
+
+using namespace imp;
+
+
+static RgbImage<int> test_rgb(index_t height, index_t width)
+{
+    RgbImage<int> image(height, width);
+
+    for (index_t y = 0; y < height; ++y)
+        for (index_t x = 0; x < width; ++x)
+        {
+            image.r(x, y) = int(10*x + y);
+            image.g(x, y) = int(100 + x*y);
+            image.b(x, y) = int(255 - x - y);
+        }
+
+    return image;
+}
+
+
+TEST(bmp_test, rgb_24bit_layout)
+{
+    RgbImage<int> img
+    ({
+        { { 1, 2, 3 },
+          { 4, 5, 6 }, },
+
+        { { 10, 20, 30 },
+          { 40, 50, 60 }, },
+
+        { { 100, 110, 120 },
+          { 130, 140, 150 }, }
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    ex::MemoryStream stream(data.get(), 256);
+
+    bmp::save(stream, img, 255);
+
+    ASSERT_EQ(stream.position(), 54 + 2*12); // 9 bytes row padded to 12
+    ASSERT_EQ(data[0], 'B');
+    ASSERT_EQ(data[1], 'M');
+    ASSERT_EQ(data[10], 54);  // pixel offset
+    ASSERT_EQ(data[28], 24);  // bpp
+
+    // bottom-up: first stored row is the last image row, BGR order
+    const uint8_t* row = data.get() + 54;
+    ASSERT_EQ(row[0], 130);
+    ASSERT_EQ(row[1], 40);
+    ASSERT_EQ(row[2], 4);
+    ASSERT_EQ(row[9], 0); // padding
+
+    stream.seek(0);
+    ASSERT_TRUE(bmp::load_rgb<int>(stream, 255) == img);
+}
+
+
+TEST(bmp_test, gray_8bit_roundtrip)
+{
+    Matrix<int> img1
+    ({
+        { 16, 32, 3 },
+        { 16, 10, 4 }
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[2048]);
+    ex::MemoryStream stream(data.get(), 2048);
+
+    bmp::save(stream, img1, 32);
+
+    ASSERT_EQ(data[28], 8);                  // bpp
+    ASSERT_EQ(data[10] | (data[11] << 8), 54 + 1024); // palette
+
+    stream.seek(0);
+    ASSERT_TRUE(bmp::load_gray<int>(stream, 32) == img1);
+
+    RgbImage<int> rgb(2, 3);
+
+    stream.seek(0);
+    ASSERT_THROW(bmp::load_into(stream, rgb, 32), std::runtime_error);
+}
+
+
+TEST(bmp_test, load_top_down_32bit)
+{
+    // 2x1 BGRA, top-down (negative height)
+    const uint8_t file[] =
+    {
+        'B', 'M', 62, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0,
+        40, 0, 0, 0,  2, 0, 0, 0,  0xff, 0xff, 0xff, 0xff,  1, 0,  32, 0,  0, 0, 0, 0,
+        8, 0, 0, 0,  0, 0, 0, 0,  0, 0, 0, 0,  0, 0, 0, 0,  0, 0, 0, 0,
+        30, 20, 10, 255,   60, 50, 40, 0,
+    };
+
+    ex::MemoryStream stream(const_cast<uint8_t*>(file), sizeof(file));
+
+    auto img = bmp::load_rgb<int>(stream, 255);
+
+    ASSERT_EQ(img.width(),  2);
+    ASSERT_EQ(img.height(), 1);
+    ASSERT_EQ(img.r(0), 10);
+    ASSERT_EQ(img.g(0), 20);
+    ASSERT_EQ(img.b(0), 30);
+    ASSERT_EQ(img.r(1), 40);
+    ASSERT_EQ(img.b(1), 60);
+}
+
+
+TEST(bmp_test, mapped_bitmap_views)
+{
+    auto img = test_rgb(5, 7);
+
+    const char* file_name = "bmp_test_mapped.bmp";
+    bmp::save(file_name, img, 255);
+
+    {
+        bmp::MappedBitmap bitmap(file_name);
+
+        ASSERT_EQ(bitmap.width(),  7);
+        ASSERT_EQ(bitmap.height(), 5);
+        ASSERT_FALSE(bitmap.is_gray());
+        ASSERT_TRUE(bitmap.is_bottom_up());
+
+        // zero-copy views in file row order
+        ASSERT_TRUE(bitmap.plane(bmp::MappedBitmap::kR).colwise().reverse().cast<int>() == img.r_plane());
+        ASSERT_TRUE(bitmap.plane(bmp::MappedBitmap::kG).colwise().reverse().cast<int>() == img.g_plane());
+        ASSERT_TRUE(bitmap.plane(bmp::MappedBitmap::kB).colwise().reverse().cast<int>() == img.b_plane());
+
+        ASSERT_EQ(bitmap.file_row(0), 4);
+        ASSERT_EQ(bitmap.plane(bmp::MappedBitmap::kG)(bitmap.file_row(1), 3), img.g(1, 3));
+
+        RgbImage<int> copy(5, 7);
+        bitmap.copy_to(copy, 255);
+
+        ASSERT_TRUE(copy == img);
+
+        Matrix<int> gray(5, 7);
+        ASSERT_THROW(bitmap.copy_to(gray, 255), std::runtime_error);
+    }
+
+    std::remove(file_name);
+}
+
+
+TEST(bmp_test, mapped_gray_bitmap)
+{
+    Matrix<uint8_t> img = Matrix<uint8_t>::Zero(3, 5);
+    img << 1, 2, 3, 4, 5,
+           6, 7, 8, 9, 10,
+           11, 12, 13, 14, 15;
+
+    const char* file_name = "bmp_test_gray.bmp";
+    bmp::save(file_name, img);
+
+    {
+        bmp::MappedBitmap bitmap(file_name);
+
+        ASSERT_TRUE(bitmap.is_gray());
+        ASSERT_TRUE(bitmap.plane(0).colwise().reverse() == img);
+
+        Matrix<float> scaled(3, 5);
+        bitmap.copy_to(scaled, 255.0f);
+
+        ASSERT_TRUE(scaled == img.cast<float>());
+    }
+
+    std::remove(file_name);
+}
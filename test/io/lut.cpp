@@ -0,0 +1,343 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include <ex/stream/memory>
+#include <imp/io/lut>
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+ex::MemoryStream text_stream(std::string& text)
+{
+    return ex::MemoryStream(reinterpret_cast<uint8_t*>(&text[0]), index_t(text.size()));
+}
+
+
+void write_text(const char* file_name, const std::string& text)
+{
+    std::FILE* file = std::fopen(file_name, "wb");
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fclose(file);
+}
+
+
+Vector<float, 3> swap_rb(const Vector<float, 3>& rgb)
+{
+    return { rgb(2), rgb(1)*0.5f, rgb(0) };
+}
+
+
+}
+
+
+TEST(lut_io_test, load_cube_3d)
+{
+    std::string text =
+        "# comment\n"
+        "TITLE \"test\"\r\n"
+        "LUT_3D_SIZE 2\n"
+        "DOMAIN_MIN 0 0 0\n"
+        "DOMAIN_MAX 1.0 1.0 1.0\n"
+        "\n"
+        "0 0 0\n"
+        "1 0 0\n"
+        "0 1 0\n"
+        "1 1 0\n"
+        "0 0 1\n"
+        "1 0 1\n"
+        "0 1 1\n"
+        "1 1 0.5\r\n";
+
+    auto stream = text_stream(text);
+    auto lut = lut::load_cube(stream);
+
+    ASSERT_EQ(lut.size(), 2);
+    ASSERT_EQ(lut.node(1, 0, 0)[0], 1.0f);
+    ASSERT_EQ(lut.node(0, 1, 0)[1], 1.0f);
+    ASSERT_EQ(lut.node(0, 0, 1)[2], 1.0f);
+    ASSERT_EQ(lut.node(1, 1, 1)[2], 0.5f);
+}
+
+
+TEST(lut_io_test, load_cube_1d)
+{
+    std::string text =
+        "LUT_1D_SIZE 3\n"
+        "0.0 0.0 1.0\n"
+        "0.25 0.5 0.5\n"
+        "1.0 1.0 0.0\n";
+
+    auto stream = text_stream(text);
+    auto curves = lut::load_cube_1d<3>(stream);
+
+    ASSERT_EQ(curves[0][1], 0.25f);
+    ASSERT_EQ(curves[1][1], 0.5f);
+    ASSERT_EQ(curves[2][0], 1.0f);
+    ASSERT_FLOAT_EQ(curves[0](0.25f), 0.125f);
+
+    stream.seek(0);
+    ASSERT_THROW(lut::load_cube_1d<4>(stream), std::runtime_error);
+
+    stream.seek(0);
+    ASSERT_THROW(lut::load_cube(stream), std::runtime_error);
+}
+
+
+TEST(lut_io_test, long_header_lines)
+{
+    std::string text =
+        "# " + std::string(1000, 'c') + "\n"
+        "TITLE \"" + std::string(700, 't') + "\"\n"
+        "LUT_1D_SIZE 2\n"
+        "0 0 0\n"
+        "1 1 1\n";
+
+    auto stream = text_stream(text);
+    auto curves = lut::load_cube_1d<2>(stream);
+
+    ASSERT_EQ(curves[1][1], 1.0f);
+}
+
+
+TEST(lut_io_test, load_3dl)
+{
+    std::string text = "3DMESH\nMesh 1 12\n0 4095\n";
+
+    // blue varies fastest
+    for (int r = 0; r < 2; ++r)
+        for (int g = 0; g < 2; ++g)
+            for (int b = 0; b < 2; ++b)
+            {
+                text += std::to_string(r*4095) + " " + std::to_string(g*2048) + " " + std::to_string(b*1000) + "\n";
+            }
+
+    auto stream = text_stream(text);
+    auto lut = lut::load_3dl(stream);
+
+    ASSERT_EQ(lut.size(), 2);
+    ASSERT_EQ(lut.node(1, 0, 0)[0], 1.0f);
+    ASSERT_EQ(lut.node(1, 0, 0)[2], 0.0f);
+    ASSERT_FLOAT_EQ(lut.node(0, 1, 0)[1], 2048.0f/4095);
+    ASSERT_FLOAT_EQ(lut.node(0, 0, 1)[2], 1000.0f/4095);
+
+    // no Mesh line: 10-bit guessed by maximum code
+    std::string text10 = "0 1023\n";
+    for (int i = 0; i < 8; ++i) text10 += "1023 512 0\n";
+
+    auto stream10 = text_stream(text10);
+    ASSERT_FLOAT_EQ(lut::load_3dl(stream10).node(1, 1, 1)[1], 512.0f/1023);
+
+    // usual 17 node mesh: 0 64 ... 960 1023
+    std::string text17;
+    for (int i = 0; i < 17; ++i) text17 += std::to_string(std::min(64*i, 1023)) + (i < 16 ? " " : "\n");
+    for (int i = 0; i < 17*17*17; ++i) text17 += "0 0 1023\n";
+
+    auto stream17 = text_stream(text17);
+    ASSERT_EQ(lut::load_3dl(stream17).size(), 17);
+
+    // shaper (non-uniform) and shifted meshes are not linearized silently
+    for (std::string mesh : { "0 100 1023\n", "0 512 512\n", "16 520 1023\n", "0 0\n" })
+    {
+        for (int i = 0; i < 27; ++i) mesh += "1023 512 0\n";
+
+        auto stream = text_stream(mesh);
+        ASSERT_THROW(lut::load_3dl(stream), std::runtime_error) << mesh.substr(0, 12);
+    }
+}
+
+
+TEST(lut_io_test, errors)
+{
+    std::string truncated = "LUT_3D_SIZE 2\n0 0 0\n1 0 0\n";
+    std::string domain    = "LUT_3D_SIZE 2\nDOMAIN_MAX 2 2 2\n";
+    std::string keyword   = "LUT_3D_SIZE 2\nLUT_SHAPER 4\n";
+    std::string extra     = "LUT_1D_SIZE 2\n0 0 0\n1 1 1 1\n";
+
+    for (std::string* text : { &truncated, &domain, &keyword, &extra })
+    {
+        auto stream = text_stream(*text);
+        ASSERT_THROW(lut::load_cube(stream), std::runtime_error);
+    }
+}
+
+
+TEST(lut_io_test, save_load_roundtrip)
+{
+    auto lut = make_lut3d<float>(5, swap_rb);
+
+    const char* file_name = "lut_io_test.cube";
+    lut::save_cube(file_name, lut, "swap");
+
+    auto loaded = lut::load<float, Trilinear>(file_name);
+
+    ASSERT_EQ(loaded.size(), 5);
+
+    for (index_t i = 0; i < lut.capacity(); ++i)
+    {
+        ASSERT_EQ(loaded.data()[i], lut.data()[i]);
+    }
+
+    // out of range nodes: no fixed point overflow of the line buffer
+    lut.data()[0] = 1e30f;
+    lut.data()[1] = -std::numeric_limits<float>::max();
+    lut.data()[2] = std::numeric_limits<float>::denorm_min();
+
+    lut::save_cube(file_name, lut);
+
+    loaded = lut::load<float, Trilinear>(file_name);
+
+    for (index_t i = 0; i < lut.capacity(); ++i)
+    {
+        ASSERT_EQ(loaded.data()[i], lut.data()[i]);
+    }
+
+    std::remove(file_name);
+}
+
+
+TEST(lut_io_test, binary_cache)
+{
+    const char* file_name = "lut_io_cache.cube";
+    std::string cache = lut::cache_name(file_name);
+
+    lut::save_cube(file_name, make_lut3d<float>(9, swap_rb));
+    std::remove(cache.c_str());
+
+    auto parsed = lut::load_cached(file_name);      // builds the cache
+
+    ASSERT_EQ(internal::file_stamp(cache.c_str()).size, 64 + 3*9*9*9*4);
+
+    auto cached = lut::load_cached(file_name, true); // maps the cache
+
+    ASSERT_TRUE(cached == parsed);
+
+    // corrupt payload: hash check rebuilds the cache
+    {
+        std::FILE* file = std::fopen(cache.c_str(), "r+b");
+        std::fseek(file, 64 + 12, SEEK_SET);
+        float garbage = 42.0f;
+        std::fwrite(&garbage, sizeof(garbage), 1, file);
+        std::fclose(file);
+    }
+
+    ASSERT_EQ(lut::load_cached(file_name, false).data()[3], 42.0f); // size check only
+    ASSERT_TRUE(lut::load_cached(file_name, true) == parsed);
+    ASSERT_TRUE(lut::load_cached(file_name, false) == parsed);      // rebuilt
+
+    // changed source: stale cache is replaced
+    lut::save_cube(file_name, make_lut3d<float>(3, swap_rb));
+
+    auto parsed_small = lut::load_cached(file_name);
+
+    ASSERT_EQ(parsed_small.size(), 3);
+    ASSERT_EQ(internal::file_stamp(cache.c_str()).size, 64 + 3*3*3*3*4);
+
+    // rebuild doesn't touch the file mapped by a reader
+    {
+        internal::MappedFile mapping(cache.c_str());
+
+        lut::save_cube(file_name, make_lut3d<float>(5, swap_rb));
+
+        ASSERT_EQ(lut::load_cached(file_name).size(), 5);
+        ASSERT_EQ(mapping.size(), 64 + 3*3*3*3*4);
+        ASSERT_EQ(reinterpret_cast<const internal::LutCacheHeader*>(mapping.data())->size, 3u);
+        ASSERT_EQ(reinterpret_cast<const float*>(mapping.data() + 64)[3*3*3*3 - 1], parsed_small.data()[3*3*3*3 - 1]);
+    }
+
+    // same size source rewritten within a second: nanosecond time stamps tell them apart
+    {
+        std::string first = "LUT_3D_SIZE 2\n", second = first;
+
+        for (int i = 0; i < 8; ++i)
+        {
+            first  += "0.1 0.2 0.3\n";
+            second += "0.3 0.2 0.1\n";
+        }
+
+        write_text(file_name, first);
+        ASSERT_EQ(lut::load_cached(file_name).data()[0], 0.1f);
+
+        auto before = internal::file_stamp(file_name);
+
+        write_text(file_name, second);
+
+        if (internal::file_stamp(file_name) != before)
+        {
+            ASSERT_EQ(lut::load_cached(file_name).data()[0], 0.3f);
+        }
+    }
+
+    // foreign file at the cache location
+    write_text(cache.c_str(), "not a cache");
+    ASSERT_EQ(lut::load_cached(file_name).size(), 2);
+
+    std::remove(file_name);
+    std::remove(cache.c_str());
+}
+
+
+
+TEST(lut_io_test, binary_cache_1d)
+{
+    const char* file_name = "lut_io_cache_1d.cube";
+    std::string cache = lut::cache_name(file_name);
+
+    write_text(file_name, "LUT_1D_SIZE 3\n"
+                          "0.0 0.0 1.0\n"
+                          "0.25 0.5 0.5\n"
+                          "1.0 1.0 0.0\n");
+    std::remove(cache.c_str());
+
+    auto parsed = lut::load_cached_1d<3>(file_name);     // builds the cache
+
+    ASSERT_EQ(internal::file_stamp(cache.c_str()).size, 64 + 3*3*4);
+
+    auto cached = lut::load_cached_1d<3>(file_name, true); // maps the cache
+
+    for (index_t c = 0; c < 3; ++c)
+        for (index_t i = 0; i < 3; ++i)
+            ASSERT_EQ(cached[size_t(c)][i], parsed[size_t(c)][i]);
+
+    ASSERT_EQ(cached[0][1], 0.25f);
+    ASSERT_EQ(cached[2][0], 1.0f);
+
+    ASSERT_THROW(lut::load_cached_1d<4>(file_name), std::runtime_error);
+    ASSERT_THROW(lut::load_cached(file_name), std::runtime_error);
+
+    std::remove(file_name);
+    std::remove(cache.c_str());
+}
+
+TEST(lut_io_test, cache_size_bound)
+{
+    const char* file_name = "lut_io_bound.cube";
+    std::string cache = lut::cache_name(file_name);
+
+    lut::save_cube(file_name, make_lut3d<float>(3, swap_rb));
+
+    // (2^22)^3 nodes wrap to an empty payload: header only cache
+    internal::LutData data = { 3, 2, {} };
+    internal::LutCacheHeader header = internal::make_cache_header(data, internal::file_stamp(file_name));
+    header.size = 1u << 22;
+
+    write_text(cache.c_str(), std::string(reinterpret_cast<const char*>(&header), sizeof(header)));
+
+    {
+        internal::MappedFile mapping(cache.c_str());
+        ASSERT_EQ(internal::check_lut_cache(mapping, internal::file_stamp(file_name), 3, false), nullptr);
+    }
+
+    ASSERT_EQ(lut::load_cached(file_name).size(), 3);
+
+    std::remove(file_name);
+    std::remove(cache.c_str());
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <ex/stream/memory>
+#include <imp/io/pam>
+
+
+static std::string header_of(ex::MemoryStream& stream)
+{
+    const char* text = reinterpret_cast<const char*>(stream.data());
+    const char* end  = std::strstr(text, "ENDHDR\n");
+
+    return end == nullptr ? "" : std::string(text, end + 7);
+}
+
+
+TEST(pam_test, gray_header)
+{
+    imp::Matrix<int> img
+    ({
+       { 4,   8 },
+       { 16, 24 },
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    ex::MemoryStream stream(data.get(), 256);
+
+    imp::pam::save(stream, img, 24);
+
+    ASSERT_EQ(header_of(stream), "P7\nWIDTH 2\nHEIGHT 2\nDEPTH 1\nMAXVAL 255\nTUPLTYPE GRAYSCALE\nENDHDR\n");
+
+    const uint8_t* content = stream.data() + header_of(stream).size();
+    ASSERT_EQ(content[0], 0x2b);
+    ASSERT_EQ(content[1], 0x55);
+    ASSERT_EQ(content[2], 0xaa);
+    ASSERT_EQ(content[3], 0xff);
+}
+
+
+TEST(pam_test, rgb_interleave)
+{
+    imp::RgbImage<int> img
+    ({
+        { { 16, 16 },
+          { 16, 16 }, },
+
+        { { 255, 255 },
+          { 255, 255 }, },
+
+        { { 32, 32 },
+          { 32, 32 }, }
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    ex::MemoryStream stream(data.get(), 256);
+
+    imp::pam::save(stream, img, 255);
+
+    std::string header = header_of(stream);
+    ASSERT_EQ(header, "P7\nWIDTH 2\nHEIGHT 2\nDEPTH 3\nMAXVAL 255\nTUPLTYPE RGB\nENDHDR\n");
+
+    const uint8_t* content = stream.data() + header.size();
+    for (index_t i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(content[3*i + 0], 16);
+        ASSERT_EQ(content[3*i + 1], 255);
+        ASSERT_EQ(content[3*i + 2], 32);
+    }
+}
+
+
+TEST(pam_test, rgba_16bit_roundtrip)
+{
+    imp::pam::PamImage<uint16_t> img1(2, 3, 4, "RGB_ALPHA");
+
+    for (index_t c = 0; c < img1.depth(); ++c)
+        for (index_t i = 0; i < img1.plane_size(); ++i)
+        {
+            img1.plane(c)(i) = uint16_t(1000*c + 100*i);
+        }
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[512]);
+    ex::MemoryStream stream(data.get(), 512);
+
+    imp::pam::save(stream, img1, uint16_t(4000));
+    ASSERT_NE(header_of(stream).find("MAXVAL 65535\nTUPLTYPE RGB_ALPHA\n"), std::string::npos);
+
+    stream.seek(0);
+    auto img2 = imp::pam::load<uint16_t>(stream, uint16_t(4000));
+
+    ASSERT_EQ(img2.depth(), 4);
+    ASSERT_EQ(img2.tuple_type(), "RGB_ALPHA");
+    ASSERT_TRUE(img2 == img1);
+}
+
+
+TEST(pam_test, load_arbitrary_maxval)
+{
+    const char file[] = "P7\n# comment\nWIDTH 2\nHEIGHT 1\nDEPTH 2\nMAXVAL 1023\nTUPLTYPE GRAYSCALE_ALPHA\nENDHDR\n"
+                        "\x03\xff\x00\x00\x01\xff\x02\x00";
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    std::memcpy(data.get(), file, sizeof(file));
+    ex::MemoryStream stream(data.get(), 256);
+
+    auto img = imp::pam::load<uint16_t>(stream, uint16_t(1023));
+
+    ASSERT_EQ(img.width(),  2);
+    ASSERT_EQ(img.height(), 1);
+    ASSERT_EQ(img.tuple_type(), "GRAYSCALE_ALPHA");
+    ASSERT_EQ(img.plane(0)(0), 1023);
+    ASSERT_EQ(img.plane(1)(0), 0);
+    ASSERT_EQ(img.plane(0)(1), 511);
+    ASSERT_EQ(img.plane(1)(1), 512);
+}
+
+
+TEST(pam_test, multi_word_tuple_type)
+{
+    const char file[] = "P7\nWIDTH 1\nHEIGHT 1\nDEPTH 2\nMAXVAL 255\nTUPLTYPE GRAYSCALE_ALPHA  premultiplied \r\n"
+                        "TUPLTYPE  custom\nENDHDR\n\x01\x02";
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    std::memcpy(data.get(), file, sizeof(file));
+    ex::MemoryStream stream(data.get(), 256);
+
+    auto img = imp::pam::load<uint8_t>(stream);
+
+    ASSERT_EQ(img.tuple_type(), "GRAYSCALE_ALPHA  premultiplied custom");
+}
+
+
+TEST(pam_test, compare_sizes)
+{
+    imp::pam::PamImage<uint8_t> wide(2, 4, 1), tall(4, 2, 1);
+
+    std::fill(wide.data(), wide.data() + wide.size(), uint8_t(7));
+    std::fill(tall.data(), tall.data() + tall.size(), uint8_t(7));
+
+    ASSERT_FALSE(wide == tall);
+    ASSERT_TRUE(wide != tall);
+    ASSERT_TRUE(wide == wide);
+}
+
+
+TEST(pam_test, load_into_rgb)
+{
+    imp::RgbImage<int> img1
+    ({
+        { { 16, 1600, 16 },
+          { 16, 16,   16 }, },
+
+        { { 1600, 1600, 1600 },
+          { 1600, 0,    1600 }, },
+
+        { { 32, 32, 32 },
+          { 32, 32, 32 }, }
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    ex::MemoryStream stream(data.get(), 256);
+
+    imp::pam::save(stream, img1, 1600);
+
+    imp::RgbImage<int> img2(2, 3);
+    const int* storage = img2.data();
+
+    stream.seek(0);
+    imp::pam::load_into(stream, img2, 1600);
+
+    ASSERT_TRUE(img2 == img1);
+    ASSERT_EQ(img2.data(), storage);
+
+    imp::Matrix<int> gray(2, 3);
+
+    stream.seek(0);
+    ASSERT_THROW(imp::pam::load_into(stream, gray, 1600), std::runtime_error);
+}
+
+
+TEST(pam_test, unsupported_depth)
+{
+    const char file[] = "P7\nWIDTH 1\nHEIGHT 1\nDEPTH 5\nMAXVAL 255\nENDHDR\n\x01\x02\x03\x04\x05";
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    std::memcpy(data.get(), file, sizeof(file));
+    ex::MemoryStream stream(data.get(), 256);
+
+    ASSERT_THROW(imp::pam::load<uint8_t>(stream), std::runtime_error);
+}
+
+
+TEST(pam_test, sample_above_maxval)
+{
+    const char file[] = "P7\nWIDTH 2\nHEIGHT 1\nDEPTH 1\nMAXVAL 3\nENDHDR\n\x02\xff";
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    std::memcpy(data.get(), file, sizeof(file));
+    ex::MemoryStream stream(data.get(), 256);
+
+    ASSERT_THROW(imp::pam::load<uint8_t>(stream), std::runtime_error);
+
+    const char file16[] = "P7\nWIDTH 1\nHEIGHT 1\nDEPTH 1\nMAXVAL 1023\nENDHDR\n\x04\x00";
+
+    std::memcpy(data.get(), file16, sizeof(file16));
+    stream.seek(0);
+
+    ASSERT_THROW(imp::pam::load<uint16_t>(stream), std::runtime_error);
+}
@@ -173,3 +173,113 @@ TEST(pgm_test, load_with_black_level)
 
     ASSERT_TRUE(img2 == img1);
 }
+
+
+TEST(pgm_test, load_into_reuse_storage)
+{
+    imp::Matrix<int> img1
+    ({
+        { 16, 32, 3 },
+        { 16, 10, 4 }
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    ex::MemoryStream stream(data.get(), 256);
+
+    imp::pgm::save(stream, img1, 32);
+
+    imp::Matrix<int> img2(2, 3);
+    const int* storage = img2.data();
+
+    stream.seek(0);
+    imp::pgm::load_into(stream, img2, 32);
+
+    ASSERT_TRUE(img2 == img1);
+    ASSERT_EQ(img2.data(), storage);
+}
+
+
+TEST(pgm_test, load_into_block)
+{
+    imp::Matrix<int> img1
+    ({
+        { 16, 1600 },
+        { 32, 800  }
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    ex::MemoryStream stream(data.get(), 256);
+
+    imp::pgm::save(stream, img1, 1600);
+
+    imp::Matrix<int> frame = imp::Matrix<int>::Zero(4, 4);
+
+    stream.seek(0);
+    imp::pgm::load_into(stream, frame.block(1, 2, 2, 2), 1600);
+
+    ASSERT_TRUE(frame.block(1, 2, 2, 2) == img1);
+    ASSERT_EQ(frame.sum(), img1.sum());
+}
+
+
+TEST(pgm_test, load_into_size_mismatch)
+{
+    imp::Matrix<int> img1
+    ({
+        { 16, 32, 3 },
+        { 16, 10, 4 }
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    ex::MemoryStream stream(data.get(), 256);
+
+    imp::pgm::save(stream, img1, 32);
+
+    imp::Matrix<int> img2(3, 2);
+
+    stream.seek(0);
+    ASSERT_THROW(imp::pgm::load_into(stream, img2, 32), std::runtime_error);
+}
+
+
+TEST(pgm_test, load_changing_levels)
+{
+    imp::Matrix<int> img1
+    ({
+        { 16, 32,  18 },
+        { 16, 255, 18 },
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    ex::MemoryStream stream(data.get(), 256);
+
+    imp::pgm::save(stream, img1, 255, 16);
+
+    stream.seek(0);
+    auto img2 = imp::pgm::load<int>(stream, 255, 16);
+
+    stream.seek(0);
+    auto img3 = imp::pgm::load<int>(stream, 255);
+
+    stream.seek(0);
+    auto img4 = imp::pgm::load<int>(stream, 255, 16);
+
+    ASSERT_TRUE(img2 == img1);
+    ASSERT_EQ(img3(0, 0), 0);
+    ASSERT_EQ(img3(1, 1), 255);
+    ASSERT_TRUE(img4 == img1);
+}
+
+
+TEST(pgm_test, cached_tables_outlive_cache)
+{
+    auto lut1 = imp::internal::decode_lut<int>(255, 255, 16);
+    auto lut2 = imp::internal::decode_lut<int>(255, 255, 0);   // replaces the cached table
+
+    ASSERT_NE(lut1, lut2);
+    ASSERT_EQ((*lut1)[0], 16);
+    ASSERT_EQ((*lut2)[0], 0);
+    ASSERT_EQ((*lut1)[255], 255);
+
+    ASSERT_EQ(imp::internal::decode_lut<int>(255, 255, 0), lut2); // same key: cached table
+}
@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <ex/stream/memory>
+#include <imp/io/png>
+
+
+using namespace imp;
+
+
+template <typename T>
+static RgbImage<T> gradient(index_t height, index_t width, T white_level)
+{
+    RgbImage<T> image(height, width);
+
+    for (index_t y = 0; y < height; ++y)
+        for (index_t x = 0; x < width; ++x)
+        {
+            image.r(x, y) = T((x*7 + y*3) % (white_level + 1));
+            image.g(x, y) = T((x*y) % (white_level + 1));
+            image.b(x, y) = T((white_level - x) > 0 ? (white_level - x) % (white_level + 1) : 0);
+        }
+
+    return image;
+}
+
+
+TEST(png_test, load_reference_file)
+{
+    // 3x3 gray 8-bit, rows filtered with None/Up/Sub, zlib level 9, with tEXt chunk
+    const uint8_t file[] =
+    {
+        0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+        0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x08, 0x00, 0x00, 0x00, 0x00, 0x73, 0x43, 0xea,
+        0x63, 0x00, 0x00, 0x00, 0x0a, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74,
+        0x00, 0x68, 0x69, 0xa2, 0xa2, 0x58, 0x66, 0x00, 0x00, 0x00, 0x12, 0x49, 0x44, 0x41, 0x54, 0x78,
+        0xda, 0x63, 0xe0, 0x12, 0x91, 0x63, 0x62, 0x04, 0x02, 0x56, 0x56, 0x56, 0x00, 0x02, 0x94, 0x00,
+        0x52, 0x2f, 0xb4, 0x18, 0x41, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60,
+        0x82
+    };
+
+    ex::MemoryStream stream(const_cast<uint8_t*>(file), sizeof(file));
+
+    Matrix<int> expected
+    ({
+        { 10, 20, 30 },
+        { 11, 21, 31 },
+        { 5,  10, 15 },
+    });
+
+    ASSERT_TRUE(png::load_gray<int>(stream, 255) == expected);
+}
+
+
+TEST(png_test, gray_8bit_roundtrip)
+{
+    Matrix<int> img1
+    ({
+        { 16, 32, 3 },
+        { 16, 10, 4 }
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[1024]);
+    ex::MemoryStream stream(data.get(), 1024);
+
+    png::save(stream, img1, 32);
+
+    ASSERT_EQ(data[24], 8); // bit depth
+    ASSERT_EQ(data[25], 0); // gray
+
+    stream.seek(0);
+    ASSERT_TRUE(png::load_gray<int>(stream, 32) == img1);
+}
+
+
+TEST(png_test, rgb_16bit_roundtrip)
+{
+    auto img1 = gradient<uint16_t>(37, 53, 4095);
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[64*1024]);
+    ex::MemoryStream stream(data.get(), 64*1024);
+
+    png::save(stream, img1, uint16_t(4095));
+
+    ASSERT_EQ(data[24], 16); // bit depth
+    ASSERT_EQ(data[25], 2);  // RGB
+
+    stream.seek(0);
+    ASSERT_TRUE(png::load_rgb<uint16_t>(stream, uint16_t(4095)) == img1);
+}
+
+
+TEST(png_test, all_filters_and_levels)
+{
+    auto img1 = gradient<uint8_t>(19, 23, 255);
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[64*1024]);
+    ex::MemoryStream stream(data.get(), 64*1024);
+
+    for (int filter = png::kNone; filter <= png::kAdaptive; ++filter)
+        for (int level : { png::kStore, png::kFast, png::kDefault, png::kBest })
+        {
+            png::Options options;
+            options.compression = level;
+            options.filter      = png::Filter(filter);
+
+            stream.seek(0);
+            png::save(stream, img1, uint8_t(255), uint8_t(0), options);
+
+            stream.seek(0);
+            ASSERT_TRUE(png::load_rgb<uint8_t>(stream) == img1);
+        }
+}
+
+
+TEST(png_test, output_independent_of_threads)
+{
+    // ~1.3 MB of filtered data -> several independently deflated chunks
+    auto img1 = gradient<uint16_t>(300, 750, 65535);
+
+    index_t capacity = 4*1024*1024;
+    std::unique_ptr<uint8_t[]> data1(new uint8_t[size_t(capacity)]);
+    std::unique_ptr<uint8_t[]> data2(new uint8_t[size_t(capacity)]);
+    ex::MemoryStream stream1(data1.get(), capacity);
+    ex::MemoryStream stream2(data2.get(), capacity);
+
+    png::Options single;
+    single.threads = 1;
+
+    png::Options multi;
+    multi.threads = 4;
+
+    png::save(stream1, img1, uint16_t(65535), uint16_t(0), single);
+    png::save(stream2, img1, uint16_t(65535), uint16_t(0), multi);
+
+    ASSERT_EQ(stream1.position(), stream2.position());
+    ASSERT_TRUE(std::equal(data1.get(), data1.get() + stream1.position(), data2.get()));
+
+    stream2.seek(0);
+    ASSERT_TRUE(png::load_rgb<uint16_t>(stream2) == img1);
+}
+
+
+TEST(png_test, load_into)
+{
+    Matrix<int> img1
+    ({
+        { 16, 1600 },
+        { 32, 800  }
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[1024]);
+    ex::MemoryStream stream(data.get(), 1024);
+
+    png::save(stream, img1, 1600);
+
+    Matrix<int> frame = Matrix<int>::Zero(4, 4);
+
+    stream.seek(0);
+    png::load_into(stream, frame.block(1, 1, 2, 2), 1600);
+    ASSERT_TRUE(frame.block(1, 1, 2, 2) == img1);
+
+    RgbImage<int> rgb(2, 2);
+
+    stream.seek(0);
+    ASSERT_THROW(png::load_into(stream, rgb, 1600), std::runtime_error);
+}
+
+
+TEST(png_test, corrupted_crc)
+{
+    Matrix<uint8_t> img1 = Matrix<uint8_t>::Constant(4, 4, 7);
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[1024]);
+    ex::MemoryStream stream(data.get(), 1024);
+
+    png::save(stream, img1);
+
+    data[20] ^= 0x01; // IHDR content
+
+    stream.seek(0);
+    ASSERT_THROW(png::load_gray<uint8_t>(stream), std::runtime_error);
+}
+
+
+TEST(png_test, wrong_header_size)
+{
+    Matrix<uint8_t> img1 = Matrix<uint8_t>::Constant(4, 4, 7);
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[1024]);
+    ex::MemoryStream stream(data.get(), 1024);
+
+    png::save(stream, img1);
+
+    std::unique_ptr<uint8_t[]> copy(new uint8_t[1024]);
+    std::copy(data.get(), data.get() + 1024, copy.get());
+
+    // IHDR width, height and a valid chunk CRC
+    for (index_t offset : { 16, 20 })
+        for (uint32_t size : { 0u, 0x80000000u })
+        {
+            std::copy(copy.get(), copy.get() + 1024, data.get());
+            internal::store_be32(data.get() + offset, size);
+            internal::store_be32(data.get() + 29, uint32_t(crc32(0L, data.get() + 12, 17)));
+
+            stream.seek(0);
+            ASSERT_THROW(png::load_gray<uint8_t>(stream), std::runtime_error) << offset << " " << size;
+        }
+}
+
+
+TEST(png_test, corrupted_stream_tail)
+{
+    Matrix<uint8_t> img1 = Matrix<uint8_t>::Constant(4, 4, 7);
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[1024]);
+    ex::MemoryStream stream(data.get(), 1024);
+
+    png::save(stream, img1);
+
+    const char* idat = "IDAT";
+    const index_t type   = index_t(std::search(data.get(), data.get() + 1024, idat, idat + 4) - data.get());
+    const index_t length = index_t(internal::load_be32(data.get() + type - 4));
+    const index_t crc    = type + 4 + length;
+
+    std::unique_ptr<uint8_t[]> copy(new uint8_t[1024]);
+    std::copy(data.get(), data.get() + 1024, copy.get());
+
+    // CRC of the last IDAT chunk
+    data[crc + 3] ^= 0x01;
+
+    stream.seek(0);
+    ASSERT_THROW(png::load_gray<uint8_t>(stream), std::runtime_error);
+
+    // zlib adler32 with a valid chunk CRC
+    std::copy(copy.get(), copy.get() + 1024, data.get());
+    data[crc - 1] ^= 0x01;
+    internal::store_be32(data.get() + crc, uint32_t(crc32(0L, data.get() + type, uInt(length + 4))));
+
+    stream.seek(0);
+    ASSERT_THROW(png::load_gray<uint8_t>(stream), std::runtime_error);
+
+    // chunk length above 2^31 - 1
+    std::copy(copy.get(), copy.get() + 1024, data.get());
+    internal::store_be32(data.get() + 8, 0xFFFFFFF0u);
+
+    stream.seek(0);
+    ASSERT_THROW(png::load_gray<uint8_t>(stream), std::runtime_error);
+
+    std::copy(copy.get(), copy.get() + 1024, data.get());
+
+    stream.seek(0);
+    ASSERT_TRUE(png::load_gray<uint8_t>(stream) == img1);
+}
@@ -263,3 +263,80 @@ TEST(ppm_test, load_with_black_level)
 
     ASSERT_TRUE(img2 == img1);
 }
+
+
+TEST(ppm_test, load_into_reuse_storage)
+{
+    imp::RgbImage<int> img1
+    ({
+        { { 16, 16, 16 },
+          { 16, 16, 16 }, },
+
+        { { 1600, 1600, 1600 },
+          { 1600, 1600, 1600 }, },
+
+        { { 32, 32, 32 },
+          { 32, 32, 32 }, }
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    ex::MemoryStream stream(data.get(), 256);
+
+    imp::ppm::save(stream, img1, 1600);
+
+    imp::RgbImage<int> img2(2, 3);
+    const int* storage = img2.data();
+
+    stream.seek(0);
+    imp::ppm::load_into(stream, img2, 1600);
+
+    ASSERT_TRUE(img2 == img1);
+    ASSERT_EQ(img2.data(), storage);
+}
+
+
+TEST(ppm_test, load_into_mapped_memory)
+{
+    imp::RgbImage<int> img1
+    ({
+        { { 16, 16 },
+          { 16, 16 }, },
+
+        { { 255, 255 },
+          { 255, 255 }, },
+
+        { { 32, 32 },
+          { 32, 32 }, }
+    });
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    ex::MemoryStream stream(data.get(), 256);
+
+    imp::ppm::save(stream, img1, 255);
+
+    int buffer[3*2*2] = { 0 };
+    imp::RgbImage<int> view(2, 2, buffer, imp::RawMemory::kMap);
+
+    stream.seek(0);
+    imp::ppm::load_into(stream, view, 255);
+
+    ASSERT_TRUE(view == img1);
+    ASSERT_EQ(buffer[4], 255);
+}
+
+
+TEST(ppm_test, load_into_size_mismatch)
+{
+    imp::RgbImage<int> img1(2, 2);
+    img1.array() = 16;
+
+    std::unique_ptr<uint8_t[]> data(new uint8_t[256]);
+    ex::MemoryStream stream(data.get(), 256);
+
+    imp::ppm::save(stream, img1, 255);
+
+    imp::RgbImage<int> img2(2, 3);
+
+    stream.seek(0);
+    ASSERT_THROW(imp::ppm::load_into(stream, img2, 255), std::runtime_error);
+}
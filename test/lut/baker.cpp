@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <imp/lut/baker>
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+Vector<float, 3> decode(const Vector<float, 3>& rgb)
+{
+    return rgb.array().pow(2.2f).matrix();
+}
+
+
+Vector<float, 3> mix(const Vector<float, 3>& rgb)
+{
+    Matrix<float, 3, 3> m;
+    m << 0.8f, 0.1f, 0.1f,
+         0.1f, 0.8f, 0.1f,
+         0.0f, 0.2f, 0.8f;
+
+    return m*rgb;
+}
+
+
+Vector<float, 3> encode(const Vector<float, 3>& rgb)
+{
+    return rgb.array().max(0.0f).pow(1/2.2f).matrix();
+}
+
+
+}
+
+
+TEST(baker_test, pipeline_order)
+{
+    auto chain = pipeline([](int x) { return x + 1; },
+                          [](int x) { return x*10; },
+                          [](int x) { return x - 3; });
+
+    ASSERT_EQ(chain(2), 27);
+    ASSERT_EQ(pipeline([](int x) { return x*2; })(4), 8);
+}
+
+
+TEST(baker_test, bake_lut3d_error)
+{
+    auto chain = pipeline(decode, mix, encode);
+
+    BakeError coarse;
+    BakeError fine;
+
+    auto lut9  = bake_lut3d<float>(9, chain, &coarse);
+    auto lut33 = bake_lut3d<float>(33, chain, &fine, 3);
+
+    // nodes are exact
+    auto node = chain(Vector<float, 3>(0.25f, 0.5f, 1.0f));
+
+    ASSERT_NEAR(lut9.node(2, 4, 8)[0], node(0), 1e-6f);
+    ASSERT_NEAR(lut9.node(2, 4, 8)[2], node(2), 1e-6f);
+
+    ASSERT_EQ(coarse.samples, 8*8*8);
+    ASSERT_EQ(fine.samples, 32*32*32);
+
+    ASSERT_GT(coarse.max_error, fine.max_error);
+    ASSERT_GE(fine.max_error, fine.mean_error);
+    ASSERT_LT(fine.max_error, 0.05);
+    ASSERT_LT(fine.mean_error, 1e-3);
+
+    // error report matches an independent measurement
+    BakeError check = measure_error(lut33, chain, 32);
+
+    ASSERT_DOUBLE_EQ(check.max_error, fine.max_error);
+
+    // affine transforms are reproduced exactly
+    BakeError affine;
+    bake_lut3d<float, Trilinear>(5, mix, &affine);
+
+    ASSERT_LT(affine.max_error, 1e-5);
+}
+
+
+TEST(baker_test, bake_lut1d_error)
+{
+    auto curve = [](float x) { return std::pow(x, 1/2.4f); };
+
+    BakeError coarse;
+    BakeError fine;
+
+    auto lut64   = bake_lut1d<float, 64>(curve, &coarse);
+    auto lut4096 = bake_lut1d<float, 4096>(curve, &fine);
+
+    ASSERT_FLOAT_EQ(lut64[63], 1.0f);
+    ASSERT_FLOAT_EQ(lut4096[2048], curve(2048.0f/4095));
+
+    ASSERT_EQ(fine.samples, 4*4095);
+    ASSERT_GT(coarse.max_error, fine.max_error);
+    ASSERT_LT(fine.mean_error, 1e-5);
+
+    // integral tables: rounded nodes, error in codes
+    BakeError codes;
+    auto lut8 = bake_lut1d<uint8_t, 256>([](float x) { return 255*x*x; }, &codes);
+
+    ASSERT_EQ(lut8[128], 64);
+    ASSERT_LT(codes.max_error, 1.0); // node rounding + output rounding
+}
+
+
+TEST(baker_test, nan_output_fails_validation)
+{
+    auto broken = [](const Vector<float, 3>& rgb)
+    {
+        return Vector<float, 3>(rgb(0), rgb(1) > 0.5f ? std::nanf("") : rgb(1), rgb(2));
+    };
+
+    BakeError error3d;
+    bake_lut3d<float>(9, broken, &error3d);
+
+    ASSERT_TRUE(std::isinf(error3d.max_error));
+    ASSERT_TRUE(std::isinf(error3d.mean_error));
+    ASSERT_EQ(error3d.samples, 8*8*8);
+
+    BakeError error1d;
+    bake_lut1d<float, 5>([](float x) { return x < 0.9f ? x : std::nanf(""); }, &error1d);
+
+    ASSERT_TRUE(std::isinf(error1d.max_error));
+    ASSERT_EQ(error1d.samples, 4*4);
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <imp/lut/lut1d>
+#include <imp/image/rgb_image>
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+struct Negative
+{
+    constexpr uint8_t operator()(index_t i) const { return uint8_t(255 - i); }
+};
+
+
+struct Ramp
+{
+    constexpr float operator()(index_t i) const { return float(i) / 4.0f; }
+};
+
+
+}
+
+
+TEST(lut1d_test, compile_time_initialization)
+{
+    constexpr auto negative = make_lut1d<uint8_t, 256>(Negative{});
+
+    static_assert(negative[0] == 255, "compile-time table");
+    static_assert(negative[255] == 0, "compile-time table");
+    static_assert(negative(10) == 245, "compile-time lookup");
+
+    constexpr auto ramp = make_lut1d<float, 5>(Ramp{});
+
+    static_assert(ramp(0.5f) == 0.5f, "compile-time interpolation");
+
+    constexpr auto codes = lut_cast<int>(make_lut1d<float, 5>(Ramp{}));
+
+    static_assert(codes[1] == 0 && codes[2] == 1 && codes[4] == 1, "rounded cast");
+
+    ASSERT_EQ(negative.size(), 256);
+}
+
+
+TEST(lut1d_test, integral_exact_indexing)
+{
+    auto lut = make_lut1d<uint16_t, 256>([](index_t i) { return uint16_t(i*i); });
+
+    Matrix<uint8_t> img(2, 3);
+    img << 0, 1, 2,
+           16, 255, 128;
+
+    Matrix<uint16_t> expected(2, 3);
+    expected << 0, 1, 4,
+                256, 65025, 16384;
+
+    ASSERT_TRUE(lut.apply(img) == expected);
+
+    Matrix<int> out_of_range(1, 2);
+    out_of_range << -5, 1000;
+
+    ASSERT_EQ(lut.apply(out_of_range)(0), 0);
+    ASSERT_EQ(lut.apply(out_of_range)(1), 65025);
+}
+
+
+
+TEST(lut1d_test, integral_wide_input_clamp)
+{
+    constexpr auto negative = make_lut1d<uint8_t, 256>(Negative{});
+
+    static_assert(negative(uint32_t(3000000000u)) == 0, "large unsigned input");
+    static_assert(negative(int64_t(-5000000000)) == 255, "large negative input");
+
+    Matrix<uint32_t> img(1, 3);
+    img << 3000000000u, 4294967295u, 7;
+
+    Matrix<uint8_t> expected(1, 3);
+    expected << 0, 0, 248;
+
+    ASSERT_TRUE(negative.apply(img) == expected);
+
+    Matrix<int64_t> wide(1, 4);
+    wide << (int64_t(1) << 40), -(int64_t(1) << 40), int64_t(4294967296) + 3, 3;
+
+    Matrix<uint8_t> expected_wide(1, 4);
+    expected_wide << 0, 255, 0, 252;
+
+    ASSERT_TRUE(negative.apply(wide) == expected_wide);
+}
+
+TEST(lut1d_test, floating_interpolation)
+{
+    auto square = make_lut1d<float, 1025>([](index_t i) { float x = float(i)/1024; return x*x; });
+
+    Matrix<float> img(3, 4);
+    img << 0.0f, 0.1f, 0.25f, 0.3333f,
+           0.5f, 0.7f, 0.9f,  1.0f,
+          -1.0f, 2.0f, 0.01f, 0.999f;
+
+    auto result = square.apply(img);
+
+    for (index_t i = 0; i < 8; ++i)
+    {
+        ASSERT_NEAR(result(i), img(i)*img(i), 1e-6f);
+    }
+
+    ASSERT_EQ(result(8), 0.0f);  // clamped
+    ASSERT_EQ(result(9), 1.0f);
+    ASSERT_NEAR(result(10), 1e-4f, 1e-6f);
+    ASSERT_NEAR(result(11), 0.998f, 1e-5f);
+
+    // integral output is rounded
+    auto codes = make_lut1d<uint8_t, 2>([](index_t i) { return uint8_t(i*255); });
+
+    ASSERT_EQ(codes(0.5f), 128);
+    ASSERT_EQ(codes(0.1f), 26);
+
+    // NaN reads the first sample, infinities are clamped
+    Matrix<float> special(1, 4);
+    special << std::nanf(""), -std::nanf(""), INFINITY, -INFINITY;
+
+    Matrix<float> expected(1, 4);
+    expected << 0.0f, 0.0f, 1.0f, 0.0f;
+
+    ASSERT_TRUE(square.apply(special) == expected);
+    ASSERT_EQ(codes(std::nan("")), 0);
+}
+
+
+TEST(lut1d_test, in_place_views)
+{
+    auto lut = make_lut1d<float, 256>([](index_t i) { return float(i)*2; });
+
+    Matrix<int> img = Matrix<int>::Constant(4, 5, 3);
+
+    lut.apply(ex::in_place, img.block(1, 1, 2, 3));
+
+    ASSERT_EQ(img(0, 0), 3);
+    ASSERT_EQ(img(1, 1), 6);
+    ASSERT_EQ(img(2, 3), 6);
+    ASSERT_EQ(img(3, 4), 3);
+
+    RgbImage<float> rgb(3, 4);
+    rgb.array().setConstant(0.5f);
+
+    auto half = make_lut1d<float, 3>([](index_t i) { return float(i)*10; });
+
+    half.apply(ex::in_place, rgb.g_plane());
+
+    ASSERT_TRUE(rgb.r_plane() == Matrix<float>::Constant(3, 4, 0.5f));
+    ASSERT_TRUE(rgb.g_plane() == Matrix<float>::Constant(3, 4, 10.0f));
+}
+
+
+TEST(lut1d_test, image_multithreaded)
+{
+    RgbImage<uint8_t> rgb(67, 31);
+
+    for (index_t i = 0; i < rgb.size(); ++i)
+    {
+        rgb[i] = uint8_t(i*7);
+    }
+
+    constexpr auto negative = make_lut1d<uint8_t, 256>(Negative{});
+
+    auto single = negative.apply(rgb, 1);
+    auto multi  = negative.apply(rgb, 4);
+
+    ASSERT_TRUE(single == multi);
+
+    for (index_t i = 0; i < rgb.size(); ++i)
+    {
+        ASSERT_EQ(single[i], 255 - rgb[i]);
+    }
+
+    auto wide = make_lut1d<uint16_t, 256>([](index_t i) { return uint16_t(i*257); });
+    RgbImage<uint16_t> converted = wide.apply(rgb, 3);
+
+    ASSERT_EQ(converted.r(5, 5), rgb.r(5, 5)*257);
+
+    negative.apply(ex::in_place, rgb, 4);
+
+    ASSERT_TRUE(rgb == single);
+}
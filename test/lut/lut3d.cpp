@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <imp/lut/lut3d>
+#include <imp/image/rgb_image>
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+Vector<float, 3> affine(const Vector<float, 3>& rgb)
+{
+    return { 0.5f*rgb(0) + 0.25f*rgb(1) + 0.1f, rgb(2), 1.0f - rgb(0) };
+}
+
+
+Vector<float, 3> curve(const Vector<float, 3>& rgb)
+{
+    return { std::sqrt(rgb(0)*rgb(1)), rgb(2)*rgb(2), std::sin(rgb(0) + rgb(2)) };
+}
+
+
+RgbImage<float> test_image(index_t height, index_t width)
+{
+    RgbImage<float> image(height, width);
+
+    for (index_t i = 0; i < image.plane_size(); ++i)
+    {
+        image.r(i) = float((i*37) % 101) / 100;
+        image.g(i) = float((i*53) % 97) / 96;
+        image.b(i) = float((i*11) % 89) / 88;
+    }
+
+    return image;
+}
+
+
+// reference tetrahedral interpolation with explicit 6-case branching
+Vector<float, 3> tetrahedral(const Lut3d<float>& lut, float r, float g, float b)
+{
+    index_t n = lut.size();
+
+    auto cell = [n](float v, index_t& i)
+    {
+        float p = v*float(n - 1);
+        i = std::min(index_t(p), n - 2);
+        return p - float(i);
+    };
+
+    index_t ir, ig, ib;
+    float x = cell(r, ir), y = cell(g, ig), z = cell(b, ib);
+
+    auto c = [&](index_t dr, index_t dg, index_t db)
+    {
+        const float* p = lut.node(ir + dr, ig + dg, ib + db);
+        return Vector<float, 3>(p[0], p[1], p[2]);
+    };
+
+    Vector<float, 3> c000 = c(0, 0, 0), c111 = c(1, 1, 1);
+
+    if (x >= y && y >= z) return (1 - x)*c000 + (x - y)*c(1, 0, 0) + (y - z)*c(1, 1, 0) + z*c111;
+    if (x >= z && z >= y) return (1 - x)*c000 + (x - z)*c(1, 0, 0) + (z - y)*c(1, 0, 1) + y*c111;
+    if (z >= x && x >= y) return (1 - z)*c000 + (z - x)*c(0, 0, 1) + (x - y)*c(1, 0, 1) + y*c111;
+    if (y >= x && x >= z) return (1 - y)*c000 + (y - x)*c(0, 1, 0) + (x - z)*c(1, 1, 0) + z*c111;
+    if (y >= z && z >= x) return (1 - y)*c000 + (y - z)*c(0, 1, 0) + (z - x)*c(0, 1, 1) + x*c111;
+
+    return (1 - z)*c000 + (z - y)*c(0, 0, 1) + (y - x)*c(0, 1, 1) + x*c111;
+}
+
+
+}
+
+
+TEST(lut3d_test, layout)
+{
+    auto lut = make_lut3d<float>(3, [](const Vector<float, 3>& rgb) { return rgb; });
+
+    ASSERT_EQ(lut.size(), 3);
+    ASSERT_EQ(lut.capacity(), 81);
+
+    // red varies fastest
+    ASSERT_EQ(lut.data()[3], 0.5f);
+    ASSERT_EQ(lut.data()[3*3 + 1], 0.5f);
+    ASSERT_EQ(lut.data()[3*9 + 2], 0.5f);
+    ASSERT_EQ(lut.node(2, 1, 0)[0], 1.0f);
+
+    ASSERT_THROW(Lut3d<float>(1), std::logic_error);
+    ASSERT_THROW(Lut3d<float>(257), std::logic_error);
+}
+
+
+TEST(lut3d_test, affine_exact)
+{
+    // both interpolations reproduce affine transforms exactly
+    auto tetra = make_lut3d<float, Tetrahedral>(5, affine);
+    auto tri   = make_lut3d<float, Trilinear>(5, affine);
+
+    auto image = test_image(7, 13);
+
+    auto a = tetra.apply(image);
+    auto b = tri.apply(image);
+
+    for (index_t i = 0; i < image.plane_size(); ++i)
+    {
+        auto expected = affine(Vector<float, 3>(image.r(i), image.g(i), image.b(i)));
+
+        ASSERT_NEAR(a.r(i), expected(0), 1e-5f);
+        ASSERT_NEAR(a.g(i), expected(1), 1e-5f);
+        ASSERT_NEAR(a.b(i), expected(2), 1e-5f);
+
+        ASSERT_NEAR(b.r(i), expected(0), 1e-5f);
+        ASSERT_NEAR(b.g(i), expected(1), 1e-5f);
+        ASSERT_NEAR(b.b(i), expected(2), 1e-5f);
+    }
+}
+
+
+TEST(lut3d_test, nan_input)
+{
+    auto tetra = make_lut3d<float, Tetrahedral>(5, affine);
+    auto tri   = make_lut3d<float, Trilinear>(5, affine);
+
+    // NaN samples are read as 0, infinities are clamped: a full block and a tail
+    RgbImage<float> image(3, 70);
+
+    for (index_t i = 0; i < image.plane_size(); ++i)
+    {
+        bool special = i % 3 == 0;
+
+        image.r(i) = special ? std::nanf("") : 0.5f;
+        image.g(i) = special ? ((i % 2 == 0) ? -std::nanf("") : INFINITY) : 0.5f;
+        image.b(i) = special ? -INFINITY : 0.5f;
+    }
+
+    for (auto result : { tetra.apply(image), tri.apply(image) })
+        for (index_t i = 0; i < image.plane_size(); ++i)
+        {
+            float g = (i % 3 != 0) ? 0.5f : (i % 2 == 0) ? 0.0f : 1.0f;
+            float b = (i % 3 != 0) ? 0.5f : 0.0f;
+
+            auto expected = affine(Vector<float, 3>(i % 3 == 0 ? 0.0f : 0.5f, g, b));
+
+            ASSERT_NEAR(result.r(i), expected(0), 1e-5f) << i;
+            ASSERT_NEAR(result.g(i), expected(1), 1e-5f) << i;
+            ASSERT_NEAR(result.b(i), expected(2), 1e-5f) << i;
+        }
+}
+
+
+TEST(lut3d_test, tetrahedral_reference)
+{
+    auto lut = make_lut3d<float>(9, curve);
+
+    auto image = test_image(11, 150); // several blocks per row
+
+    auto result = lut.apply(image);
+
+    for (index_t i = 0; i < image.plane_size(); ++i)
+    {
+        auto expected = tetrahedral(lut, image.r(i), image.g(i), image.b(i));
+
+        ASSERT_NEAR(result.r(i), expected(0), 1e-5f);
+        ASSERT_NEAR(result.g(i), expected(1), 1e-5f);
+        ASSERT_NEAR(result.b(i), expected(2), 1e-5f);
+    }
+
+    // ties and the upper edge
+    auto corner = lut(1.0f, 1.0f, 1.0f);
+    auto node   = lut.node(8, 8, 8);
+
+    ASSERT_NEAR(corner(0), node[0], 1e-6f);
+    ASSERT_NEAR(corner(2), node[2], 1e-6f);
+
+    auto tie = lut(0.3f, 0.3f, 0.3f);
+    auto ref = tetrahedral(lut, 0.3f, 0.3f, 0.3f);
+
+    ASSERT_NEAR(tie(1), ref(1), 1e-6f);
+}
+
+
+TEST(lut3d_test, integral_image)
+{
+    auto lut = make_lut3d<float>(17, [](const Vector<float, 3>& rgb) -> Vector<float, 3>
+    {
+        return { rgb(2), rgb(1), rgb(0)*2 }; // swap r/b, overflow blue
+    });
+
+    RgbImage<uint16_t> image(4, 5);
+
+    for (index_t i = 0; i < image.plane_size(); ++i)
+    {
+        image.r(i) = uint16_t(i*3000);
+        image.g(i) = uint16_t(65535 - i*1000);
+        image.b(i) = uint16_t(i*17);
+    }
+
+    auto result = lut.apply(image);
+
+    for (index_t i = 0; i < image.plane_size(); ++i)
+    {
+        ASSERT_NEAR(result.r(i), image.b(i), 1);
+        ASSERT_NEAR(result.g(i), image.g(i), 1);
+        ASSERT_NEAR(result.b(i), std::min(2*image.r(i), 65535), 2);
+    }
+
+    auto codes = image;
+    lut.apply(ex::in_place, codes, uint16_t(65535), 3);
+
+    ASSERT_TRUE(codes == result);
+}
+
+
+TEST(lut3d_test, multithreaded)
+{
+    auto lut = make_lut3d<float, Trilinear>(33, curve);
+
+    auto image = test_image(101, 77);
+
+    auto single = lut.apply(image, 1.0f, 1);
+    auto multi  = lut.apply(image, 1.0f, 4);
+
+    ASSERT_TRUE(single == multi);
+
+    lut.apply(ex::in_place, image, 1.0f, 4);
+
+    ASSERT_TRUE(image == single);
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+#include <imp/common/matrix>
+#include <imp/image/rgb_image>
+#include <imp/transform/geometry>
+
+#include "fixture"
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+template <typename T>
+Matrix<T> naive_rotate(const Matrix<T>& matrix, Rotation rotation)
+{
+    const index_t h = matrix.rows(), w = matrix.cols();
+
+    Matrix<T> result(rotation == kRotate180 ? h : w, rotation == kRotate180 ? w : h);
+
+    for (index_t y = 0; y < h; ++y)
+        for (index_t x = 0; x < w; ++x)
+        {
+            switch (rotation)
+            {
+                case kRotate90:  result(x, h - 1 - y)         = matrix(y, x); break;
+                case kRotate180: result(h - 1 - y, w - 1 - x) = matrix(y, x); break;
+                case kRotate270: result(w - 1 - x, y)         = matrix(y, x); break;
+            }
+        }
+
+    return result;
+}
+
+
+}
+
+
+TEST(geometry, transpose)
+{
+    for (auto size : { std::make_pair(index_t(1), index_t(1)), std::make_pair(index_t(7), index_t(13)),
+                       std::make_pair(index_t(64), index_t(65)), std::make_pair(index_t(130), index_t(257)) })
+    {
+        auto bytes  = fixture::random_matrix<uint8_t>(size.first, size.second);
+        auto floats = fixture::random_matrix<float>(size.first, size.second, 3);
+
+        for (index_t threads : { 1, 3 })
+        {
+            ASSERT_TRUE(transpose(bytes, threads) == Matrix<uint8_t>(bytes.transpose())) << size.first << "x" << size.second;
+            ASSERT_TRUE(transpose(floats, threads) == Matrix<float>(floats.transpose())) << size.first << "x" << size.second;
+        }
+    }
+
+    // expressions: blocks (strided rows) and transposes (evaluated)
+    auto matrix = fixture::random_matrix<int16_t>(90, 140);
+
+    ASSERT_TRUE(transpose(matrix.block(3, 5, 70, 101), 2) == Matrix<int16_t>(matrix.block(3, 5, 70, 101).transpose()));
+    ASSERT_TRUE(transpose(matrix.transpose()) == matrix);
+
+    Matrix<double, 3, 4> fixed = fixture::random_matrix<double>(3, 4);
+    Matrix<double, 4, 3> fixed_t = transpose(fixed);
+
+    ASSERT_TRUE(fixed_t == fixed.transpose());
+    ASSERT_EQ(transpose(Matrix<float>(0, 5)).rows(), 5);
+}
+
+
+TEST(geometry, rotate_and_flip)
+{
+    for (auto size : { std::make_pair(index_t(1), index_t(9)), std::make_pair(index_t(33), index_t(70)),
+                       std::make_pair(index_t(129), index_t(66)) })
+    {
+        auto matrix = fixture::random_matrix<uint8_t>(size.first, size.second);
+
+        for (auto rotation : { kRotate90, kRotate180, kRotate270 })
+            ASSERT_TRUE(rotate(matrix, rotation, 2) == naive_rotate(matrix, rotation)) << rotation << ": " << size.first;
+
+        ASSERT_TRUE(flip(matrix, kFlipHorizontal) == Matrix<uint8_t>(matrix.rowwise().reverse()));
+        ASSERT_TRUE(flip(matrix, kFlipVertical, 3) == Matrix<uint8_t>(matrix.colwise().reverse()));
+
+        ASSERT_TRUE(rotate(rotate(matrix, kRotate90), kRotate270) == matrix);
+        ASSERT_TRUE(rotate(matrix.transpose(), kRotate90) == flip(transpose(matrix.transpose()), kFlipHorizontal));
+    }
+
+    // matrices and arrays like transpose(), fixed sizes of square ones
+    Array<float> array = fixture::random_matrix<float>(5, 8).array();
+
+    static_assert(std::is_same<decltype(rotate(array, kRotate90)), Array<float>>::value, "rotate of an array");
+    static_assert(std::is_same<decltype(rotate(Matrix<double, 3, 3>(), kRotate90)), Matrix<double, 3, 3>>::value, "rotate of a square");
+
+    ASSERT_TRUE(rotate(array, kRotate270).matrix() == naive_rotate(Matrix<float>(array.matrix()), kRotate270));
+}
+
+
+TEST(geometry, in_place)
+{
+    for (index_t n : { 1, 8, 67, 130 })
+    {
+        auto matrix = fixture::random_matrix<float>(n, n);
+
+        for (index_t threads : { 1, 2 })
+        {
+            auto copy = matrix;
+
+            transpose(ex::in_place, copy, threads);
+
+            ASSERT_TRUE(copy == matrix.transpose()) << n;
+
+            for (auto rotation : { kRotate90, kRotate180, kRotate270 })
+            {
+                copy = matrix;
+
+                rotate(ex::in_place, copy, rotation, threads);
+
+                ASSERT_TRUE(copy == naive_rotate(matrix, rotation)) << n << ", " << rotation;
+            }
+        }
+    }
+
+    // blocks of a larger matrix, transposed expressions
+    auto matrix = fixture::random_matrix<uint16_t>(100, 120);
+    auto copy   = matrix;
+
+    transpose(ex::in_place, copy.block(10, 20, 75, 75), 2);
+
+    ASSERT_TRUE(copy.block(10, 20, 75, 75) == matrix.block(10, 20, 75, 75).transpose());
+    ASSERT_TRUE(copy.block(0, 0, 10, 120) == matrix.block(0, 0, 10, 120));
+
+    copy = matrix;
+
+    flip(ex::in_place, copy.transpose(), kFlipHorizontal);
+
+    ASSERT_TRUE(copy == Matrix<uint16_t>(matrix.colwise().reverse()));
+
+    for (index_t height : { 7, 8 })
+    {
+        auto odd = fixture::random_matrix<uint8_t>(height, 13);
+
+        copy = odd.cast<uint16_t>();
+
+        rotate(ex::in_place, copy, kRotate180);
+
+        ASSERT_TRUE(copy == naive_rotate(odd, kRotate180).cast<uint16_t>()) << height;
+
+        flip(ex::in_place, copy, kFlipVertical);
+
+        ASSERT_TRUE(copy == Matrix<uint16_t>(odd.cast<uint16_t>().rowwise().reverse())) << height;
+    }
+
+    ASSERT_THROW(transpose(ex::in_place, matrix), std::logic_error);
+    ASSERT_THROW(rotate(ex::in_place, matrix, kRotate90), std::logic_error);
+}
+
+
+TEST(geometry, image_planes)
+{
+    RgbImage<uint8_t> image(37, 70);
+
+    for (index_t c = 0; c < 3; ++c) image.plane(c) = fixture::random_matrix<uint8_t>(37, 70, uint32_t(c + 1));
+
+    auto transposed = transpose(image, 2);
+    auto rotated    = rotate(image, kRotate270);
+    auto flipped    = flip(image, kFlipVertical);
+
+    ASSERT_EQ(transposed.height(), 70);
+    ASSERT_EQ(rotated.width(), 37);
+
+    auto copy = image;
+
+    flip(ex::in_place, copy, kFlipVertical);
+
+    ASSERT_TRUE(copy == flipped);
+
+    for (index_t c = 0; c < 3; ++c)
+    {
+        Matrix<uint8_t> plane = image.plane(c);
+
+        ASSERT_TRUE(transposed.plane(c) == plane.transpose()) << c;
+        ASSERT_TRUE(rotated.plane(c) == naive_rotate(plane, kRotate270)) << c;
+        ASSERT_TRUE(flipped.plane(c) == plane.colwise().reverse()) << c;
+    }
+}
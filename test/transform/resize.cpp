@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <imp/common/matrix>
+#include <imp/image/rgb_image>
+#include <imp/transform/resize>
+
+#include "fixture"
+
+
+using namespace imp;
+
+
+namespace
+{
+
+
+double naive_kernel(ResizeMethod method, double x)
+{
+    const double pi = 3.14159265358979323846;
+
+    x = std::abs(x);
+
+    switch (method)
+    {
+        case kResizeBilinear: return std::max(0.0, 1 - x);
+        case kResizeBicubic:  return x < 1 ? 1.5*x*x*x - 2.5*x*x + 1 : x < 2 ? -0.5*x*x*x + 2.5*x*x - 4*x + 2 : 0;
+        default:              return x == 0 ? 1 : x < 3 ? std::sin(pi*x)*std::sin(pi*x/3) / (pi*pi*x*x/3) : 0;
+    }
+}
+
+
+// weights of every source position for one output position, edges replicated
+Matrix<double> naive_weights(index_t source, index_t size, ResizeMethod method)
+{
+    const double scale   = double(source) / double(size);
+    const double stretch = std::max(scale, 1.0);
+
+    Matrix<double> weights = Matrix<double>::Zero(size, source);
+
+    for (index_t o = 0; o < size; ++o)
+    {
+        const double center = (double(o) + 0.5)*scale;
+
+        const index_t reach = index_t(3*stretch) + 2;
+
+        for (index_t i = index_t(center) - reach; i <= index_t(center) + reach; ++i)
+            weights(o, std::min(std::max<index_t>(i, 0), source - 1)) += naive_kernel(method, (double(i) + 0.5 - center) / stretch);
+
+        weights.row(o) /= weights.row(o).sum();
+    }
+
+    return weights;
+}
+
+
+template <typename T>
+Matrix<double> naive_resize(const Matrix<T>& matrix, index_t height, index_t width, ResizeMethod method)
+{
+    return naive_weights(matrix.rows(), height, method)*matrix.template cast<double>()*
+           naive_weights(matrix.cols(), width, method).transpose();
+}
+
+
+}
+
+
+TEST(resize, bilinear_values)
+{
+    Matrix<float> row(1, 2);
+
+    row << 0, 4;
+
+    // centers at -0.25, 0.25, 0.75, 1.25 of the source pixels
+    Matrix<float> expected(1, 4);
+
+    expected << 0, 1, 3, 4;
+
+    ASSERT_TRUE(Resize(1, 4, kResizeBilinear).apply(row) == expected);
+
+    // reduction by 2: antialiased, the triangle spans 4 pixels
+    Matrix<float> line(1, 8);
+
+    line << 0, 0, 8, 8, 0, 0, 8, 8;
+
+    Matrix<float> half = Resize(1, 4, kResizeBilinear).apply(line);
+
+    ASSERT_FLOAT_EQ(half(0, 1), 6.0f);  // (0*1 + 8*3 + 8*3 + 0*1) / 8
+    ASSERT_THROW(Resize(0, 4), std::logic_error);
+    ASSERT_THROW(Resize(4, 4).apply(Matrix<float>(0, 3)), std::logic_error);
+}
+
+
+TEST(resize, methods_and_sizes)
+{
+    auto source = fixture::random_matrix<float>(44, 60);
+
+    for (auto method : { kResizeBilinear, kResizeBicubic, kResizeLanczos })
+        for (auto size : { std::make_pair(index_t(44), index_t(60)),     // same size
+                           std::make_pair(index_t(22), index_t(30)),     // 2x reduction
+                           std::make_pair(index_t(88), index_t(120)),    // 2x enlargement
+                           std::make_pair(index_t(17), index_t(100)),
+                           std::make_pair(index_t(7), index_t(5)),
+                           std::make_pair(index_t(1), index_t(1)) })
+        {
+            Resize resize(size.first, size.second, method);
+
+            auto expected = naive_resize(source, size.first, size.second, method);
+            auto result   = resize.apply(source);
+
+            ASSERT_LT((result.cast<double>() - expected).cwiseAbs().maxCoeff(), 1e-3)
+                << method << ": " << size.first << "x" << size.second;
+        }
+
+    // sources smaller than the kernel
+    Matrix<float> tiny = fixture::random_matrix<float>(2, 3);
+
+    ASSERT_LT((Resize(9, 1, kResizeLanczos).apply(tiny).cast<double>() - naive_resize(tiny, 9, 1, kResizeLanczos)).cwiseAbs().maxCoeff(), 1e-4);
+
+    // constant images stay constant
+    Matrix<uint8_t> flat = Matrix<uint8_t>::Constant(33, 20, 77);
+
+    for (auto method : { kResizeBilinear, kResizeBicubic, kResizeLanczos })
+        ASSERT_TRUE(Resize(64, 41, method).apply(flat) == Matrix<uint8_t>::Constant(64, 41, 77)) << method;
+}
+
+
+TEST(resize, integral_types)
+{
+    // a step: lanczos overshoots, results are clamped
+    Matrix<uint8_t> step = Matrix<uint8_t>::Zero(10, 40);
+
+    step.rightCols(20).setConstant(255);
+
+    auto expected = naive_resize(step, 10, 67, kResizeLanczos);
+
+    Matrix<uint8_t> result = Resize(10, 67, kResizeLanczos).apply(step);
+
+    ASSERT_LE((result.cast<double>() - expected.cwiseMax(0).cwiseMin(255)).cwiseAbs().maxCoeff(), 0.51);
+    ASSERT_TRUE(expected.minCoeff() < -1 && expected.maxCoeff() > 256);
+
+    auto source = fixture::random_matrix<int16_t>(31, 44);
+
+    Matrix<double> reference = naive_resize(source, 62, 22, kResizeBicubic);
+    Matrix<int16_t> resized  = Resize(62, 22).apply(source);
+
+    ASSERT_LE((resized.cast<double>() - reference).cwiseAbs().maxCoeff(), 0.51);
+
+    // 32-bit limits: float(2^31 - 1) is 2^31, results saturate below the limit instead of wrapping
+    Matrix<int32_t> high = Matrix<int32_t>::Constant(8, 12, std::numeric_limits<int32_t>::max());
+    Matrix<int32_t> low  = Matrix<int32_t>::Constant(8, 12, std::numeric_limits<int32_t>::lowest());
+
+    Matrix<int32_t> high_result = Resize(5, 7, kResizeLanczos).apply(high);
+    Matrix<int32_t> low_result  = Resize(5, 7, kResizeLanczos).apply(low);
+
+    ASSERT_TRUE(high_result.minCoeff() >= 2147482624 && high_result.maxCoeff() == 2147483520);
+    ASSERT_TRUE(low_result.maxCoeff() <= -2147482624);
+
+    Matrix<uint32_t> high_unsigned = Matrix<uint32_t>::Constant(8, 12, std::numeric_limits<uint32_t>::max());
+    Matrix<uint32_t> unsigned_result = Resize(16, 3).apply(high_unsigned);
+
+    ASSERT_TRUE(unsigned_result.minCoeff() >= 4294965248u && unsigned_result.maxCoeff() == 4294967040u);
+}
+
+
+TEST(resize, threads_expressions_and_images)
+{
+    auto source = fixture::random_matrix<uint8_t>(130, 97);
+
+    Resize resize(65, 200, kResizeLanczos);
+
+    auto expected = resize.apply(source);
+
+    const size_t bytes = resize.weights_bytes();
+
+    for (index_t threads : { 2, 3, 8 })
+        ASSERT_TRUE(resize.apply(source, threads) == expected) << threads;
+
+    // the weights of the same geometry are reused, another source size rebuilds them
+    ASSERT_EQ(resize.weights_bytes(), bytes);
+
+    Matrix<uint8_t> transposed = Resize(200, 65, kResizeLanczos).apply(source.transpose(), 2);
+
+    ASSERT_TRUE(transposed == Resize(200, 65, kResizeLanczos).apply(Matrix<uint8_t>(source.transpose())));
+
+    Matrix<uint8_t> block = resize.apply(source.block(10, 5, 40, 60));
+
+    ASSERT_TRUE(block == resize.apply(Matrix<uint8_t>(source.block(10, 5, 40, 60))));
+    ASSERT_NE(resize.weights_bytes(), bytes);
+
+    RgbImage<uint8_t> image(40, 50);
+
+    for (index_t c = 0; c < 3; ++c) image.plane(c) = fixture::random_matrix<uint8_t>(40, 50, uint32_t(c + 1));
+
+    Resize preview(20, 25, kResizeBilinear);
+
+    auto result = preview.apply(image, 2);
+
+    ASSERT_EQ(result.height(), 20);
+    ASSERT_EQ(result.width(), 25);
+
+    for (index_t c = 0; c < 3; ++c)
+        ASSERT_TRUE(result.plane(c) == preview.apply(Matrix<uint8_t>(image.plane(c)))) << c;
+}